@@ -0,0 +1,153 @@
+#ifndef MESSAGE_REGISTRY_H
+#define MESSAGE_REGISTRY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include "SafeSerializer.h"
+
+// ==========================================
+// MESSAGE REGISTRY (Wire Type IDs)
+// ==========================================
+// Stream format: [type id (uint16_t, network order)][packed message] ...
+// Each registered type maps to a slot of a dispatch table built at compile
+// time, so decoding is one bounds check and one indirect call per message.
+//
+// Messages carry no length prefix, so only fixed-layout types can be
+// registered: their packed size is what tells a partial tail (INCOMPLETE)
+// apart from a malformed message (DECODE_ERROR).
+
+using MessageTypeId = uint16_t;
+
+enum StreamStatus_e : uint8_t {
+    STREAM_STATUS_OK = 0,           // Every byte consumed
+    STREAM_STATUS_INCOMPLETE = 1,   // Tail holds a partial message; feed more bytes
+    STREAM_STATUS_UNKNOWN_TYPE = 2,
+    STREAM_STATUS_DECODE_ERROR = 3
+};
+
+template <MessageTypeId Id, typename T>
+struct MessageEntry {
+    static constexpr MessageTypeId id = Id;
+    using type = T;
+};
+
+template <typename... Entries>
+class MessageRegistry {
+    static_assert(sizeof...(Entries) > 0, "Registry needs at least one message type");
+    static_assert((has_wire_layout<typename Entries::type>::value && ...),
+        "Registered messages need a fixed wire_layout to detect partial frames");
+
+    static constexpr bool ids_unique() {
+        constexpr std::array<MessageTypeId, sizeof...(Entries)> ids = { Entries::id... };
+        for (size_t i = 0; i < ids.size(); ++i) {
+            for (size_t j = i + 1U; j < ids.size(); ++j) {
+                if (ids[i] == ids[j]) return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    static constexpr MessageTypeId max_id = std::max({ Entries::id... });
+    static constexpr size_t table_size = static_cast<size_t>(max_id) + 1U;
+    // IDs index the table directly; keep them dense.
+    static_assert(table_size <= 4096U, "Message IDs too sparse for a direct dispatch table");
+    static_assert(ids_unique(), "Duplicate message type id");
+
+    template <typename T>
+    static constexpr MessageTypeId id_of() {
+        static_assert((std::is_same_v<T, typename Entries::type> || ...), "Type is not registered");
+        MessageTypeId id = 0;
+        ((std::is_same_v<T, typename Entries::type> ? (id = Entries::id, true) : false) || ...);
+        return id;
+    }
+
+    template <typename T>
+    static bool encode(const T& message, uint8_t* buffer, size_t buffer_len, size_t& consumed) {
+        size_t local_offset = 0;
+        if (!serialize_to_buffer(buffer, buffer_len, local_offset, id_of<T>())) return false;
+
+        size_t body_consumed = 0;
+        if (local_offset >= buffer_len) return false;
+        if (!message.serialize(buffer + local_offset, buffer_len - local_offset, body_consumed)) return false;
+        consumed = local_offset + body_consumed;
+        return true;
+    }
+
+    // Decodes one message body whose type id has already been read and hands
+    // the decoded object to handler(const T&).
+    template <typename Handler>
+    static StreamStatus_e dispatch(MessageTypeId id, const uint8_t* buffer, size_t buffer_len,
+        size_t& consumed, Handler& handler) {
+        if (static_cast<size_t>(id) >= table_size) {
+            LOG_ERROR("Unknown message type id %u", static_cast<unsigned int>(id));
+            return STREAM_STATUS_UNKNOWN_TYPE;
+        }
+        return dispatch_table<Handler>[id](buffer, buffer_len, consumed, handler);
+    }
+
+    // Decodes back-to-back messages until the buffer is exhausted or an error
+    // occurs. consumed always ends on a message boundary.
+    template <typename Handler>
+    static StreamStatus_e decode_stream(const uint8_t* buffer, size_t buffer_len, size_t& consumed,
+        Handler& handler) {
+        size_t offset = 0;
+        StreamStatus_e status = STREAM_STATUS_OK;
+
+        while ((status == STREAM_STATUS_OK) && (offset < buffer_len)) {
+            if (buffer_len - offset < sizeof(MessageTypeId)) {
+                status = STREAM_STATUS_INCOMPLETE;
+                break;
+            }
+            size_t cursor = offset;
+            MessageTypeId id = 0;
+            deserialize_from_buffer(buffer, buffer_len, cursor, id);
+
+            size_t body_consumed = 0;
+            status = dispatch(id, buffer + cursor, buffer_len - cursor, body_consumed, handler);
+            if (status == STREAM_STATUS_OK) offset = cursor + body_consumed;
+        }
+        consumed = offset;
+        return status;
+    }
+
+private:
+    template <typename Handler>
+    using Thunk = StreamStatus_e(*)(const uint8_t*, size_t, size_t&, Handler&);
+
+    template <typename T, typename Handler>
+    static StreamStatus_e decode_and_handle(const uint8_t* buffer, size_t buffer_len, size_t& consumed,
+        Handler& handler) {
+        if (buffer_len < wire_layout_t<T>::size) return STREAM_STATUS_INCOMPLETE;
+        T message = {};
+        size_t local_consumed = 0;
+        if (!message.deserialize(buffer, buffer_len, local_consumed)) return STREAM_STATUS_DECODE_ERROR;
+        consumed = local_consumed;
+        handler(static_cast<const T&>(message));
+        return STREAM_STATUS_OK;
+    }
+
+    template <typename Handler>
+    static StreamStatus_e unknown_message(const uint8_t*, size_t, size_t&, Handler&) {
+        LOG_ERROR("Unregistered message type id in dispatch table");
+        return STREAM_STATUS_UNKNOWN_TYPE;
+    }
+
+    template <typename Handler>
+    static constexpr std::array<Thunk<Handler>, table_size> make_table() {
+        std::array<Thunk<Handler>, table_size> table{};
+        for (size_t i = 0; i < table_size; ++i) {
+            table[i] = &unknown_message<Handler>;
+        }
+        ((table[Entries::id] = &decode_and_handle<typename Entries::type, Handler>), ...);
+        return table;
+    }
+
+    template <typename Handler>
+    static constexpr std::array<Thunk<Handler>, table_size> dispatch_table = make_table<Handler>();
+};
+
+#endif // MESSAGE_REGISTRY_H
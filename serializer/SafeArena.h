@@ -0,0 +1,218 @@
+#ifndef SAFE_ARENA_H
+#define SAFE_ARENA_H
+
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include "SafeSerializer.h"
+
+// ==========================================
+// MONOTONIC ARENA
+// ==========================================
+// Bump allocator over caller-provided storage. No heap, no per-object free:
+// everything handed out since the last reset() is released by one reset().
+
+class SafeArena {
+public:
+    SafeArena(uint8_t* storage, size_t capacity)
+        : storage_(storage), capacity_(capacity), used_(0), high_water_(0) {}
+
+    SafeArena(const SafeArena&) = delete;
+    SafeArena& operator=(const SafeArena&) = delete;
+
+    void* allocate(size_t size, size_t alignment) {
+        const uintptr_t base = reinterpret_cast<uintptr_t>(storage_);
+        const uintptr_t current = base + used_;
+        const uintptr_t aligned = (current + (alignment - 1U)) & ~static_cast<uintptr_t>(alignment - 1U);
+        const size_t padding = static_cast<size_t>(aligned - current);
+
+        if ((size > capacity_) || (used_ + padding > capacity_ - size)) {
+            LOG_ERROR("Arena Exhausted! Need %zu, Has %zu", size + padding, capacity_ - used_);
+            return nullptr;
+        }
+        used_ += padding + size;
+        if (used_ > high_water_) high_water_ = used_;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // Objects must be trivially destructible: reset() never runs destructors.
+    template <typename T>
+    T* allocate_array(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed");
+        if (count == 0U) return nullptr;
+        if (count > (capacity_ / sizeof(T))) {
+            LOG_ERROR("Arena Exhausted! Requested %zu elements", count);
+            return nullptr;
+        }
+        void* mem = allocate(sizeof(T) * count, alignof(T));
+        if (mem == nullptr) return nullptr;
+        T* first = static_cast<T*>(mem);
+        for (size_t i = 0; i < count; ++i) {
+            ::new (static_cast<void*>(first + i)) T{};
+        }
+        return first;
+    }
+
+    void reset() { used_ = 0; }
+
+    size_t used() const { return used_; }
+    size_t capacity() const { return capacity_; }
+    size_t high_water() const { return high_water_; }
+
+private:
+    uint8_t* storage_;
+    size_t capacity_;
+    size_t used_;
+    size_t high_water_;
+};
+
+// Arena with its storage inline, suitable for static or stack placement.
+template <size_t Capacity>
+class StaticArena : public SafeArena {
+public:
+    StaticArena() : SafeArena(storage_, Capacity) {}
+
+private:
+    alignas(std::max_align_t) uint8_t storage_[Capacity];
+};
+
+// ==========================================
+// ARENA BINDING
+// ==========================================
+// Nested deserialize() calls only see (buffer, max_len, consumed), so owned
+// fields reach the arena through the binding active on the decoding thread.
+
+class ArenaScope {
+public:
+    explicit ArenaScope(SafeArena& arena) : previous_(slot()) { slot() = &arena; }
+    ~ArenaScope() { slot() = previous_; }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    static SafeArena* current() { return slot(); }
+
+private:
+    static SafeArena*& slot() {
+        static thread_local SafeArena* bound = nullptr;
+        return bound;
+    }
+
+    SafeArena* previous_;
+};
+
+// ==========================================
+// VARIABLE-LENGTH FIELD (ARENA OWNED)
+// ==========================================
+// Wire format: element count (CountT, network order) followed by the packed
+// elements. Decoded elements live in the bound arena, so they outlive the
+// input buffer and are released together with the rest of the frame/batch.
+
+template <typename T, typename CountT = uint16_t>
+struct ArenaArray {
+    static_assert(std::is_unsigned_v<CountT>, "Count type must be unsigned");
+
+    T* data = nullptr;
+    CountT count = 0;
+
+    bool deserialize(const uint8_t* buffer, size_t max_len, size_t& consumed) {
+        size_t local_offset = 0;
+        CountT wire_count = 0;
+        if (!deserialize_from_buffer(buffer, max_len, local_offset, wire_count)) return false;
+
+        data = nullptr;
+        count = 0;
+        if (wire_count != 0U) {
+            // A forged count must not reserve arena space the buffer cannot fill.
+            const size_t remaining = max_len - local_offset;
+            if ((remaining / min_element_size()) < wire_count) {
+                LOG_ERROR("Buffer Underrun! %zu elements need at least %zu bytes, Has %zu",
+                    static_cast<size_t>(wire_count), static_cast<size_t>(wire_count) * min_element_size(), remaining);
+                return false;
+            }
+            SafeArena* arena = ArenaScope::current();
+            if (arena == nullptr) {
+                LOG_ERROR("ArenaArray decoded without a bound arena");
+                return false;
+            }
+            T* elements = arena->template allocate_array<T>(wire_count);
+            if (elements == nullptr) return false;
+
+            for (CountT i = 0; i < wire_count; ++i) {
+                if (!deserialize_from_buffer(buffer, max_len, local_offset, elements[i])) return false;
+            }
+            data = elements;
+            count = wire_count;
+        }
+        consumed = local_offset;
+        return true;
+    }
+
+    bool serialize(uint8_t* buffer, size_t max_len, size_t& consumed) const {
+        size_t local_offset = 0;
+        if (!serialize_to_buffer(buffer, max_len, local_offset, count)) return false;
+        for (CountT i = 0; i < count; ++i) {
+            if (!serialize_to_buffer(buffer, max_len, local_offset, data[i])) return false;
+        }
+        consumed = local_offset;
+        return true;
+    }
+
+    size_t trueSize() const {
+        size_t total = sizeof(CountT);
+        for (CountT i = 0; i < count; ++i) {
+            total += calculate_packed_size(data[i]);
+        }
+        return total;
+    }
+
+private:
+    // Smallest wire footprint of one element; nested variable-length
+    // elements take at least one byte.
+    static constexpr size_t min_element_size() {
+        if constexpr (has_wire_layout<T>::value || !has_deserialize<T>::value) return packed_size_of<T>();
+        else return 1U;
+    }
+};
+
+// ==========================================
+// ARENA DESERIALIZATION
+// ==========================================
+
+// Decodes one frame into arena storage. Returns nullptr on failure; partial
+// allocations are reclaimed by the next reset().
+template <typename T>
+T* arena_deserialize(SafeArena& arena, const uint8_t* buffer, size_t buffer_len, size_t& consumed) {
+    ArenaScope scope(arena);
+    T* frame = arena.template allocate_array<T>(1U);
+    if (frame == nullptr) return nullptr;
+
+    consumed = 0;
+    if (!frame->deserialize(buffer, buffer_len, consumed)) return nullptr;
+    return frame;
+}
+
+// Decodes frame_count back-to-back frames into one contiguous arena block.
+template <typename T>
+T* arena_deserialize_batch(SafeArena& arena, const uint8_t* buffer, size_t buffer_len,
+    size_t frame_count, size_t& consumed) {
+    ArenaScope scope(arena);
+    T* frames = arena.template allocate_array<T>(frame_count);
+    if (frames == nullptr) return nullptr;
+
+    size_t offset = 0;
+    for (size_t i = 0; i < frame_count; ++i) {
+        size_t frame_consumed = 0;
+        if (offset >= buffer_len) {
+            LOG_ERROR("Buffer Underrun! Frame %zu of %zu", i, frame_count);
+            return nullptr;
+        }
+        if (!frames[i].deserialize(buffer + offset, buffer_len - offset, frame_consumed)) return nullptr;
+        offset += frame_consumed;
+    }
+    consumed = offset;
+    return frames;
+}
+
+#endif // SAFE_ARENA_H
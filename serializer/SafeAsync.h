@@ -0,0 +1,290 @@
+#ifndef SAFE_ASYNC_H
+#define SAFE_ASYNC_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <coroutine>
+#include <exception>
+#include "SafeSerializer.h"
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+// ==========================================
+// COROUTINE TASK
+// ==========================================
+// Fire-and-forget: runs eagerly until its first suspension and frees its
+// frame on completion. Exceptions are not part of this codebase, so an
+// escaping one terminates.
+
+struct AsyncTask {
+    struct promise_type {
+        AsyncTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// ==========================================
+// EVENT LOOP (epoll)
+// ==========================================
+// One loop per thread drives any number of readers. Each waiting reader
+// holds a one-shot EPOLLIN registration; handles epoll cannot watch
+// (regular files) or sources without a handle are treated as always
+// readable and go through the ready list instead.
+
+struct AsyncWaiter {
+    void (*on_ready)(AsyncWaiter* self);
+    int fd;
+    bool registered;
+    AsyncWaiter* next_ready;
+};
+
+class EpollLoop {
+public:
+    static constexpr int MAX_EVENTS = 64;
+
+    EpollLoop() : epoll_fd_(::epoll_create1(EPOLL_CLOEXEC)), pending_(0), ready_head_(nullptr), ready_tail_(nullptr) {
+        if (epoll_fd_ < 0) LOG_ERROR("epoll_create1 failed (errno=%d)", errno);
+    }
+
+    ~EpollLoop() {
+        if (epoll_fd_ >= 0) ::close(epoll_fd_);
+    }
+
+    EpollLoop(const EpollLoop&) = delete;
+    EpollLoop& operator=(const EpollLoop&) = delete;
+
+    bool valid() const { return epoll_fd_ >= 0; }
+
+    // Arms a single readiness notification for waiter.
+    void watch(AsyncWaiter& waiter) {
+        pending_++;
+        if ((waiter.fd >= 0) && (epoll_fd_ >= 0)) {
+            epoll_event event = {};
+            event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+            event.data.ptr = &waiter;
+            const int op = waiter.registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+            if (::epoll_ctl(epoll_fd_, op, waiter.fd, &event) == 0) {
+                waiter.registered = true;
+                return;
+            }
+            if (errno != EPERM) LOG_ERROR("epoll_ctl failed on fd %d (errno=%d)", waiter.fd, errno);
+        }
+        push_ready(waiter);
+    }
+
+    void forget(AsyncWaiter& waiter) {
+        if (waiter.registered && (epoll_fd_ >= 0)) {
+            ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, waiter.fd, nullptr);
+            waiter.registered = false;
+        }
+    }
+
+    // Runs until no reader is waiting.
+    void run() {
+        epoll_event events[MAX_EVENTS];
+        while (pending_ > 0U) {
+            AsyncWaiter* ready = ready_head_;
+            ready_head_ = nullptr;
+            ready_tail_ = nullptr;
+            while (ready != nullptr) {
+                AsyncWaiter* waiter = ready;
+                ready = waiter->next_ready;
+                waiter->next_ready = nullptr;
+                pending_--;
+                waiter->on_ready(waiter);
+            }
+            if ((pending_ == 0U) || (ready_head_ != nullptr)) continue;
+
+            const int count = ::epoll_wait(epoll_fd_, events, MAX_EVENTS, -1);
+            if (count < 0) {
+                if (errno == EINTR) continue;
+                LOG_ERROR("epoll_wait failed (errno=%d)", errno);
+                return;
+            }
+            for (int i = 0; i < count; ++i) {
+                AsyncWaiter* waiter = static_cast<AsyncWaiter*>(events[i].data.ptr);
+                pending_--;
+                waiter->on_ready(waiter);
+            }
+        }
+    }
+
+private:
+    void push_ready(AsyncWaiter& waiter) {
+        waiter.next_ready = nullptr;
+        if (ready_tail_ == nullptr) ready_head_ = &waiter;
+        else ready_tail_->next_ready = &waiter;
+        ready_tail_ = &waiter;
+    }
+
+    int epoll_fd_;
+    size_t pending_;
+    AsyncWaiter* ready_head_;
+    AsyncWaiter* ready_tail_;
+};
+
+// ==========================================
+// BYTE SOURCES
+// ==========================================
+// A source provides:
+//   long read_some(uint8_t* dest, size_t capacity); // >0 bytes, 0 would block, -1 end/error
+//   int poll_handle() const;                         // fd for epoll, -1 if always readable
+
+class FdByteSource {
+public:
+    // Files, pipes and sockets. The fd stays owned by the caller and should
+    // be non-blocking unless it is a regular file.
+    explicit FdByteSource(int fd) : fd_(fd) {}
+
+    static bool set_nonblocking(int fd) {
+        const int flags = ::fcntl(fd, F_GETFL, 0);
+        return (flags >= 0) && (::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0);
+    }
+
+    long read_some(uint8_t* dest, size_t capacity) {
+        ssize_t result = -1;
+        do {
+            result = ::read(fd_, dest, capacity);
+        } while ((result < 0) && (errno == EINTR));
+
+        if (result > 0) return static_cast<long>(result);
+        if (result == 0) return -1;
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) return 0;
+        LOG_ERROR("read failed on fd %d (errno=%d)", fd_, errno);
+        return -1;
+    }
+
+    int poll_handle() const { return fd_; }
+
+private:
+    int fd_;
+};
+
+// ==========================================
+// ASYNC FRAME READER
+// ==========================================
+// co_await reader.next<T>() completes once a whole packed T is buffered (or
+// the source ends) and decodes it with T::deserialize straight from the
+// staging buffer. Only one next() may be outstanding per reader, and a
+// reader must outlive any pending next().
+
+template <typename T>
+struct AsyncFrameResult {
+    bool ok;    // false: source ended or frame failed to decode
+    T frame;
+};
+
+template <typename Source, size_t Capacity>
+class AsyncFrameReader : private AsyncWaiter {
+public:
+    AsyncFrameReader(Source& source, EpollLoop& loop)
+        : AsyncWaiter{ &AsyncFrameReader::on_ready_thunk, source.poll_handle(), false, nullptr },
+        source_(source), loop_(loop), begin_(0), end_(0), need_(0), ended_(false), waiting_() {}
+
+    ~AsyncFrameReader() { loop_.forget(*this); }
+
+    AsyncFrameReader(const AsyncFrameReader&) = delete;
+    AsyncFrameReader& operator=(const AsyncFrameReader&) = delete;
+
+    template <typename T>
+    class NextFrame {
+    public:
+        static constexpr size_t frame_size = packed_size_of<T>();
+
+        explicit NextFrame(AsyncFrameReader& reader) : reader_(reader) {}
+
+        bool await_ready() { return reader_.fill(frame_size); }
+        void await_suspend(std::coroutine_handle<> handle) { reader_.suspend(handle, frame_size); }
+        AsyncFrameResult<T> await_resume() {
+            AsyncFrameResult<T> result = { false, T{} };
+            result.ok = reader_.decode(result.frame, frame_size);
+            return result;
+        }
+
+    private:
+        AsyncFrameReader& reader_;
+    };
+
+    template <typename T>
+    NextFrame<T> next() {
+        static_assert(has_wire_layout<T>::value, "Async decode needs a fixed wire_layout");
+        static_assert(packed_size_of<T>() <= Capacity, "Staging buffer smaller than one frame");
+        return NextFrame<T>(*this);
+    }
+
+    size_t buffered() const { return end_ - begin_; }
+
+private:
+    // Reads until need bytes are buffered, the source would block or ends.
+    // Returns true when the awaiting coroutine can continue.
+    bool fill(size_t need) {
+        if (begin_ + need > Capacity) compact();
+        while ((!ended_) && (buffered() < need)) {
+            const long got = source_.read_some(buffer_ + end_, Capacity - end_);
+            if (got > 0) end_ += static_cast<size_t>(got);
+            else if (got == 0) break;
+            else ended_ = true;
+        }
+        return ended_ || (buffered() >= need);
+    }
+
+    void compact() {
+        const size_t remaining = buffered();
+        if ((begin_ != 0U) && (remaining != 0U)) std::memmove(buffer_, buffer_ + begin_, remaining);
+        begin_ = 0;
+        end_ = remaining;
+    }
+
+    void suspend(std::coroutine_handle<> handle, size_t need) {
+        waiting_ = handle;
+        need_ = need;
+        loop_.watch(*this);
+    }
+
+    template <typename T>
+    bool decode(T& frame, size_t frame_size) {
+        if (buffered() < frame_size) return false;
+        size_t consumed = 0;
+        if (!frame.deserialize(buffer_ + begin_, buffered(), consumed)) return false;
+        begin_ += consumed;
+        if (begin_ == end_) {
+            begin_ = 0;
+            end_ = 0;
+        }
+        return true;
+    }
+
+    static void on_ready_thunk(AsyncWaiter* waiter) {
+        AsyncFrameReader* self = static_cast<AsyncFrameReader*>(waiter);
+        if (self->fill(self->need_)) {
+            std::coroutine_handle<> handle = self->waiting_;
+            self->waiting_ = nullptr;
+            handle.resume();
+        }
+        else {
+            self->loop_.watch(*self);
+        }
+    }
+
+    Source& source_;
+    EpollLoop& loop_;
+    size_t begin_;
+    size_t end_;
+    size_t need_;
+    bool ended_;
+    std::coroutine_handle<> waiting_;
+    alignas(64) uint8_t buffer_[Capacity];
+};
+
+#endif // __linux__
+
+#endif // SAFE_ASYNC_H
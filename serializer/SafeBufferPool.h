@@ -0,0 +1,301 @@
+#ifndef SAFE_BUFFER_POOL_H
+#define SAFE_BUFFER_POOL_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include "SafeSerializer.h"
+
+// ==========================================
+// SERIALIZATION BUFFER POOL
+// ==========================================
+// Fixed set of cache-line-aligned slots, each exactly one packed frame
+// (rounded up to a whole cache line so neighbouring slots never share one).
+// Slots are never zeroed: serialize() overwrites every byte it reports.
+//
+// Each thread keeps a small free-list cache per pool in front of the shared,
+// mutex-protected free list, so steady-state acquire/release only take that
+// thread's own (uncontended) cache lock. Handles are reference counted and
+// can be copied into I/O paths; the slot returns to the pool when the last
+// handle goes away.
+//
+// The pool tracks every thread cache holding its slots: when the shared list
+// runs dry, acquire() reclaims slots parked in other threads' caches, and
+// destroying the pool detaches all of them. A thread serves at most
+// MAX_POOLS_PER_THREAD pools of one instantiation from caches; further pools
+// go straight to the shared list.
+
+template <size_t FrameSize, size_t SlotCount, size_t CacheSize = 16>
+class SerializationBufferPool {
+    static_assert(FrameSize > 0U, "Frame size must be positive");
+    static_assert(SlotCount > 0U && SlotCount <= UINT32_MAX, "Slot count out of range");
+    static_assert(CacheSize >= 2U, "Thread cache needs room to refill and flush");
+
+public:
+    static constexpr size_t CACHE_LINE = 64;
+    static constexpr size_t slot_size = ((FrameSize + CACHE_LINE - 1U) / CACHE_LINE) * CACHE_LINE;
+
+    class Handle {
+    public:
+        Handle() : pool_(nullptr), index_(0) {}
+        Handle(const Handle& other) : pool_(other.pool_), index_(other.index_) {
+            if (pool_ != nullptr) pool_->add_ref(index_);
+        }
+        Handle(Handle&& other) noexcept : pool_(other.pool_), index_(other.index_) { other.pool_ = nullptr; }
+        ~Handle() { reset(); }
+
+        Handle& operator=(const Handle& other) {
+            if (this != &other) {
+                Handle copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+        Handle& operator=(Handle&& other) noexcept {
+            if (this != &other) {
+                reset();
+                pool_ = other.pool_;
+                index_ = other.index_;
+                other.pool_ = nullptr;
+            }
+            return *this;
+        }
+
+        bool valid() const { return pool_ != nullptr; }
+        uint8_t* data() const { return (pool_ != nullptr) ? pool_->storage_[index_] : nullptr; }
+        static constexpr size_t size() { return FrameSize; }
+
+        void reset() {
+            if (pool_ != nullptr) {
+                pool_->release(index_);
+                pool_ = nullptr;
+            }
+        }
+
+    private:
+        friend class SerializationBufferPool;
+        Handle(SerializationBufferPool* pool, uint32_t index) : pool_(pool), index_(index) {}
+
+        void swap(Handle& other) {
+            SerializationBufferPool* pool = pool_;
+            const uint32_t index = index_;
+            pool_ = other.pool_;
+            index_ = other.index_;
+            other.pool_ = pool;
+            other.index_ = index;
+        }
+
+        SerializationBufferPool* pool_;
+        uint32_t index_;
+    };
+
+    static constexpr size_t MAX_POOLS_PER_THREAD = 4;
+
+    SerializationBufferPool() : free_count_(SlotCount), caches_(nullptr) {
+        // Constructed before the pool finishes constructing, so it outlives it.
+        (void)registry_mutex();
+        for (size_t i = 0; i < SlotCount; ++i) {
+            refcounts_[i].store(0U, std::memory_order_relaxed);
+            free_list_[i] = static_cast<uint32_t>(SlotCount - 1U - i);
+        }
+    }
+
+    // No handle may outlive the pool and no thread may still be using it.
+    ~SerializationBufferPool() {
+        std::lock_guard<std::mutex> registry(registry_mutex());
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (caches_ != nullptr) {
+            ThreadCache* cache = caches_;
+            std::lock_guard<std::mutex> cache_lock(cache->lock);
+            unlink(*cache);
+            cache->count = 0;
+            cache->pool.store(nullptr, std::memory_order_release);
+        }
+    }
+
+    SerializationBufferPool(const SerializationBufferPool&) = delete;
+    SerializationBufferPool& operator=(const SerializationBufferPool&) = delete;
+
+    // Returns an invalid handle when every slot is in use.
+    Handle acquire() {
+        ThreadCache* cache = bind_cache();
+        uint32_t index = 0;
+        if ((cache != nullptr) && pop_cached(*cache, index)) return claim(index);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_count_ == 0U) reclaim_cached_slots();
+        if (free_count_ == 0U) {
+            LOG_ERROR("Buffer pool exhausted (%zu slots)", SlotCount);
+            return Handle();
+        }
+        free_count_--;
+        index = free_list_[free_count_];
+
+        if (cache != nullptr) {
+            std::lock_guard<std::mutex> cache_lock(cache->lock);
+            while ((free_count_ > 0U) && (cache->count < (CacheSize / 2U))) {
+                free_count_--;
+                cache->slots[cache->count] = free_list_[free_count_];
+                cache->count++;
+            }
+        }
+        return claim(index);
+    }
+
+    // Slots on the shared free list; slots parked in thread caches are not counted.
+    size_t shared_free() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return free_count_;
+    }
+
+private:
+    // Lock order: registry_mutex() -> pool mutex_ -> ThreadCache::lock. The
+    // owning thread never takes mutex_ while holding its cache lock.
+    struct ThreadCache {
+        std::mutex lock;
+        std::atomic<SerializationBufferPool*> pool{ nullptr };  // nullptr: entry free
+        uint32_t slots[CacheSize] = {};
+        size_t count = 0;
+        ThreadCache* prev = nullptr;    // Pool's cache list, guarded by its mutex_
+        ThreadCache* next = nullptr;
+    };
+
+    struct ThreadBindings {
+        ThreadCache caches[MAX_POOLS_PER_THREAD];
+
+        // Thread exit: hand cached slots back to every pool still alive.
+        ~ThreadBindings() {
+            std::lock_guard<std::mutex> registry(registry_mutex());
+            for (ThreadCache& cache : caches) {
+                SerializationBufferPool* owner = cache.pool.load(std::memory_order_acquire);
+                if (owner != nullptr) owner->retire(cache);
+            }
+        }
+    };
+
+    static std::mutex& registry_mutex() {
+        static std::mutex registry;
+        return registry;
+    }
+
+    static ThreadBindings& thread_bindings() {
+        static thread_local ThreadBindings bindings;
+        return bindings;
+    }
+
+    // This thread's cache for this pool, registering one on first use.
+    // nullptr when the thread already caches for MAX_POOLS_PER_THREAD pools.
+    ThreadCache* bind_cache() {
+        ThreadBindings& bindings = thread_bindings();
+        for (ThreadCache& cache : bindings.caches) {
+            if (cache.pool.load(std::memory_order_relaxed) == this) return &cache;
+        }
+
+        std::lock_guard<std::mutex> registry(registry_mutex());
+        for (ThreadCache& cache : bindings.caches) {
+            if (cache.pool.load(std::memory_order_relaxed) != nullptr) continue;
+            std::lock_guard<std::mutex> lock(mutex_);
+            cache.count = 0;
+            cache.prev = nullptr;
+            cache.next = caches_;
+            if (caches_ != nullptr) caches_->prev = &cache;
+            caches_ = &cache;
+            cache.pool.store(this, std::memory_order_release);
+            return &cache;
+        }
+        return nullptr;
+    }
+
+    // Called with registry_mutex() held.
+    void retire(ThreadCache& cache) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<std::mutex> cache_lock(cache.lock);
+        while (cache.count > 0U) {
+            cache.count--;
+            free_list_[free_count_] = cache.slots[cache.count];
+            free_count_++;
+        }
+        unlink(cache);
+        cache.pool.store(nullptr, std::memory_order_release);
+    }
+
+    // Called with mutex_ held.
+    void unlink(ThreadCache& cache) {
+        if (cache.prev != nullptr) cache.prev->next = cache.next;
+        else caches_ = cache.next;
+        if (cache.next != nullptr) cache.next->prev = cache.prev;
+        cache.prev = nullptr;
+        cache.next = nullptr;
+    }
+
+    // Called with mutex_ held: pulls every slot parked in a thread cache
+    // (typically idle threads) back onto the shared list.
+    void reclaim_cached_slots() {
+        for (ThreadCache* cache = caches_; cache != nullptr; cache = cache->next) {
+            std::lock_guard<std::mutex> cache_lock(cache->lock);
+            while (cache->count > 0U) {
+                cache->count--;
+                free_list_[free_count_] = cache->slots[cache->count];
+                free_count_++;
+            }
+        }
+    }
+
+    static bool pop_cached(ThreadCache& cache, uint32_t& index) {
+        std::lock_guard<std::mutex> cache_lock(cache.lock);
+        if (cache.count == 0U) return false;
+        cache.count--;
+        index = cache.slots[cache.count];
+        return true;
+    }
+
+    Handle claim(uint32_t index) {
+        refcounts_[index].store(1U, std::memory_order_relaxed);
+        return Handle(this, index);
+    }
+
+    void add_ref(uint32_t index) {
+        refcounts_[index].fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    void release(uint32_t index) {
+        if (refcounts_[index].fetch_sub(1U, std::memory_order_acq_rel) != 1U) return;
+
+        ThreadCache* cache = bind_cache();
+        if (cache != nullptr) {
+            std::lock_guard<std::mutex> cache_lock(cache->lock);
+            if (cache->count < CacheSize) {
+                cache->slots[cache->count] = index;
+                cache->count++;
+                return;
+            }
+        }
+
+        // Cache full (or none): return this slot and half the cache together.
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_list_[free_count_] = index;
+        free_count_++;
+        if (cache != nullptr) {
+            std::lock_guard<std::mutex> cache_lock(cache->lock);
+            for (size_t i = 0; (i < (CacheSize / 2U)) && (cache->count > 0U); ++i) {
+                cache->count--;
+                free_list_[free_count_] = cache->slots[cache->count];
+                free_count_++;
+            }
+        }
+    }
+
+    alignas(CACHE_LINE) uint8_t storage_[SlotCount][slot_size];
+    std::atomic<uint32_t> refcounts_[SlotCount];
+    std::mutex mutex_;
+    uint32_t free_list_[SlotCount];
+    size_t free_count_;
+    ThreadCache* caches_;
+};
+
+// Pool sized to the packed wire size of T.
+template <typename T, size_t SlotCount, size_t CacheSize = 16>
+using FrameBufferPool = SerializationBufferPool<wire_layout_t<T>::size, SlotCount, CacheSize>;
+
+#endif // SAFE_BUFFER_POOL_H
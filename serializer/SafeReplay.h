@@ -0,0 +1,203 @@
+#ifndef SAFE_REPLAY_H
+#define SAFE_REPLAY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <type_traits>
+#include "SafeSerializer.h"
+#include "SafeScan.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// ==========================================
+// RECORDER REPLAY ENGINE
+// ==========================================
+// Republishes a recording of back-to-back serialized frames to a sink:
+//
+//   bool sink(const uint8_t* frames, size_t frame_stride, size_t count);
+//
+// returning false stops the replay. Frames are handed out as wire bytes in
+// batches; a sink that needs structs decodes them itself, so a socket or
+// ring-buffer sink never pays for a decode. Only the timestamp field is
+// read from each frame, straight from its packed offset.
+
+enum ReplayMode_e : uint8_t {
+    REPLAY_MODE_PACED = 0,          // Follow timestamp deltas scaled by speed_factor
+    REPLAY_MODE_AS_FAST_AS_POSSIBLE = 1
+};
+
+struct ReplayConfig {
+    ReplayMode_e mode;
+    double speed_factor;    // 2.0 = twice real time (paced mode only)
+    size_t batch_frames;    // Upper bound on frames per sink call
+};
+
+struct ReplayStats {
+    size_t frames_delivered;
+    size_t batches_delivered;
+    bool stopped_by_sink;
+};
+
+inline void prefetch_read(const void* address) {
+#if defined(_MSC_VER)
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#else
+    (void)address;
+#endif
+}
+
+template <auto TimestampMember>
+class RecorderReplay {
+    using Frame = member_class_t<TimestampMember>;
+    static_assert(std::is_floating_point_v<member_type_t<TimestampMember>>, "Timestamp must be in seconds");
+
+public:
+    static constexpr size_t CACHE_LINE = 64;
+
+    RecorderReplay(const uint8_t* recording, size_t recording_len, size_t frame_stride = wire_layout_t<Frame>::size)
+        : recording_(recording), frame_stride_(frame_stride), frame_count_(0) {
+        if (frame_stride_ < wire_layout_t<Frame>::size) {
+            LOG_ERROR("Frame stride %zu shorter than packed frame %zu", frame_stride_, wire_layout_t<Frame>::size);
+            return;
+        }
+        frame_count_ = recording_len / frame_stride_;
+        if ((recording_len % frame_stride_) != 0U) {
+            LOG_ERROR("Ignoring %zu trailing bytes of a partial frame", recording_len % frame_stride_);
+        }
+    }
+
+    size_t frame_count() const { return frame_count_; }
+
+    template <typename Sink>
+    ReplayStats run(const ReplayConfig& config, Sink& sink) const {
+        ReplayStats stats = { 0U, 0U, false };
+        const size_t batch = std::max<size_t>(config.batch_frames, 1U);
+
+        if (config.mode == REPLAY_MODE_AS_FAST_AS_POSSIBLE) {
+            run_unpaced(batch, sink, stats);
+        }
+        else if ((config.speed_factor > 0.0) && std::isfinite(config.speed_factor)) {
+            run_paced(batch, config.speed_factor, sink, stats);
+        }
+        else {
+            LOG_ERROR("Paced replay needs a positive, finite speed factor");
+        }
+        return stats;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    const uint8_t* frame_at(size_t index) const { return recording_ + (index * frame_stride_); }
+
+    // Touch every cache line of [first, first + count) frames.
+    void prefetch_frames(size_t first, size_t count) const {
+        if (first >= frame_count_) return;
+        const size_t end = std::min(frame_count_, first + count);
+        const uint8_t* begin_ptr = frame_at(first);
+        const size_t bytes = (end - first) * frame_stride_;
+        for (size_t line = 0; line < bytes; line += CACHE_LINE) {
+            prefetch_read(begin_ptr + line);
+        }
+    }
+
+    template <typename Sink>
+    bool deliver(size_t first, size_t count, Sink& sink, ReplayStats& stats) const {
+        if (!sink(frame_at(first), frame_stride_, count)) {
+            stats.stopped_by_sink = true;
+            return false;
+        }
+        stats.frames_delivered += count;
+        stats.batches_delivered++;
+        return true;
+    }
+
+    template <typename Sink>
+    void run_unpaced(size_t batch, Sink& sink, ReplayStats& stats) const {
+        prefetch_frames(0U, batch);
+        for (size_t first = 0; first < frame_count_; first += batch) {
+            const size_t count = std::min(batch, frame_count_ - first);
+            // Read ahead one batch while the sink works on this one.
+            prefetch_frames(first + count, batch);
+            if (!deliver(first, count, sink, stats)) return;
+        }
+    }
+
+    // A forward jump larger than this between consecutive frames is a
+    // recording discontinuity, handled like a backwards step.
+    static constexpr double MAX_FRAME_GAP_SEC = 3600.0;
+    // Bound on the wall-clock offset from the anchor, far inside the range of
+    // Clock::duration; a later frame simply re-anchors.
+    static constexpr double MAX_SCHEDULE_OFFSET_SEC = 86400.0;
+
+    // False when ts cannot be placed on the current schedule: non-finite,
+    // stepping backwards, jumping too far, or too far from the anchor.
+    static bool schedule_offset(double ts, double last_ts, double origin_ts, double speed_factor,
+        Clock::duration& offset) {
+        if ((!std::isfinite(ts)) || (ts < last_ts) || ((ts - last_ts) > MAX_FRAME_GAP_SEC)) return false;
+        const double seconds = (ts - origin_ts) / speed_factor;
+        if (!(seconds <= MAX_SCHEDULE_OFFSET_SEC)) return false;
+        offset = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+        return true;
+    }
+
+    // Each frame is due at origin + (ts - ts_origin) / speed. Every frame that
+    // is already due goes out in the same batch. A timestamp that steps
+    // backwards or jumps past MAX_FRAME_GAP_SEC re-anchors the schedule; a
+    // non-finite one goes out immediately on its own and leaves it untouched.
+    template <typename Sink>
+    void run_paced(size_t batch, double speed_factor, Sink& sink, ReplayStats& stats) const {
+        bool anchored = false;
+        double origin_ts = 0.0;
+        double last_ts = 0.0;
+        Clock::time_point origin_wall = Clock::now();
+        size_t next = 0;
+
+        while (next < frame_count_) {
+            const double ts = static_cast<double>(load_wire_field<TimestampMember>(frame_at(next)));
+            if (!std::isfinite(ts)) {
+                if (!deliver(next, 1U, sink, stats)) return;
+                next++;
+                continue;
+            }
+
+            Clock::duration offset = Clock::duration::zero();
+            if ((!anchored) || (!schedule_offset(ts, last_ts, origin_ts, speed_factor, offset))) {
+                origin_ts = ts;
+                origin_wall = Clock::now();
+                offset = Clock::duration::zero();
+                anchored = true;
+            }
+            std::this_thread::sleep_until(origin_wall + offset);
+
+            const Clock::time_point now = Clock::now();
+            size_t count = 1;
+            last_ts = ts;
+            while ((count < batch) && (next + count < frame_count_)) {
+                const double candidate = static_cast<double>(load_wire_field<TimestampMember>(frame_at(next + count)));
+                Clock::duration candidate_offset = Clock::duration::zero();
+                if (!schedule_offset(candidate, last_ts, origin_ts, speed_factor, candidate_offset)) break;
+                if (origin_wall + candidate_offset > now) break;
+                last_ts = candidate;
+                count++;
+            }
+
+            if (!deliver(next, count, sink, stats)) return;
+            next += count;
+        }
+    }
+
+    const uint8_t* recording_;
+    size_t frame_stride_;
+    size_t frame_count_;
+};
+
+#endif // SAFE_REPLAY_H
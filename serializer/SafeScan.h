@@ -0,0 +1,294 @@
+#ifndef SAFE_SCAN_H
+#define SAFE_SCAN_H
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include "SafeSerializer.h"
+
+// ==========================================
+// WIRE FIELD LOADS (No Decode)
+// ==========================================
+// Frames are scanned in blocks: each referenced field is gathered for the
+// whole block into a small array, then compared in a tight loop the
+// compiler can vectorize. Only the referenced bytes of a frame are touched.
+
+constexpr size_t SCAN_BLOCK_FRAMES = 16;
+
+template <auto Member>
+member_type_t<Member> load_wire_field(const uint8_t* frame) {
+    using T = member_type_t<Member>;
+    static_assert(!has_wire_layout<T>::value, "Nested structs cannot be loaded as a scalar");
+    constexpr size_t offset = wire_layout_t<member_class_t<Member>>::template offset_of<Member>();
+
+    T value;
+    safe_read_from_buffer(value, frame + offset);
+    return safe_ntoh(value);
+}
+
+template <auto Member>
+void gather_field_block(const uint8_t* frames, size_t frame_stride, size_t count, member_type_t<Member>* out) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = load_wire_field<Member>(frames + (i * frame_stride));
+    }
+}
+
+// ==========================================
+// SCAN PREDICATES
+// ==========================================
+// Built with field_gt/field_lt/... and combined with scan_and/scan_or/scan_not
+// (named combinators: overloaded && and || would lose short-circuit semantics).
+// evaluate() writes one 0/1 byte per frame of the block into mask.
+// Combinators short-circuit per block: the right-hand side is not gathered
+// when the left-hand mask already decides every frame of the block.
+
+enum CompareOp_e : uint8_t { COMPARE_LT = 0, COMPARE_LE, COMPARE_GT, COMPARE_GE, COMPARE_EQ, COMPARE_NE };
+
+template <auto Member, CompareOp_e Op>
+struct FieldPredicate {
+    using frame_type = member_class_t<Member>;
+    using value_type = member_type_t<Member>;
+
+    value_type operand;
+
+    void evaluate(const uint8_t* frames, size_t frame_stride, size_t count, uint8_t* mask) const {
+        value_type values[SCAN_BLOCK_FRAMES];
+        gather_field_block<Member>(frames, frame_stride, count, values);
+
+        const value_type rhs = operand;
+        for (size_t i = 0; i < count; ++i) {
+            bool hit = false;
+            if constexpr (Op == COMPARE_LT) hit = values[i] < rhs;
+            else if constexpr (Op == COMPARE_LE) hit = values[i] <= rhs;
+            else if constexpr (Op == COMPARE_GT) hit = values[i] > rhs;
+            else if constexpr (Op == COMPARE_GE) hit = values[i] >= rhs;
+            else if constexpr (Op == COMPARE_EQ) hit = values[i] == rhs;
+            else hit = values[i] != rhs;
+            mask[i] = static_cast<uint8_t>(hit);
+        }
+    }
+};
+
+template <typename Lhs, typename Rhs, bool IsAnd>
+struct CombinedPredicate {
+    static_assert(std::is_same_v<typename Lhs::frame_type, typename Rhs::frame_type>,
+        "Predicates must refer to the same frame type");
+    using frame_type = typename Lhs::frame_type;
+
+    Lhs lhs;
+    Rhs rhs;
+
+    void evaluate(const uint8_t* frames, size_t frame_stride, size_t count, uint8_t* mask) const {
+        uint8_t rhs_mask[SCAN_BLOCK_FRAMES];
+        lhs.evaluate(frames, frame_stride, count, mask);
+
+        uint8_t any_hit = 0U;
+        uint8_t all_hit = 1U;
+        for (size_t i = 0; i < count; ++i) {
+            any_hit = static_cast<uint8_t>(any_hit | mask[i]);
+            all_hit = static_cast<uint8_t>(all_hit & mask[i]);
+        }
+        if constexpr (IsAnd) {
+            if (any_hit == 0U) return;
+        }
+        else {
+            if (all_hit != 0U) return;
+        }
+
+        rhs.evaluate(frames, frame_stride, count, rhs_mask);
+        for (size_t i = 0; i < count; ++i) {
+            if constexpr (IsAnd) mask[i] = static_cast<uint8_t>(mask[i] & rhs_mask[i]);
+            else mask[i] = static_cast<uint8_t>(mask[i] | rhs_mask[i]);
+        }
+    }
+};
+
+template <typename Inner>
+struct NotPredicate {
+    using frame_type = typename Inner::frame_type;
+
+    Inner inner;
+
+    void evaluate(const uint8_t* frames, size_t frame_stride, size_t count, uint8_t* mask) const {
+        inner.evaluate(frames, frame_stride, count, mask);
+        for (size_t i = 0; i < count; ++i) {
+            mask[i] = static_cast<uint8_t>(mask[i] ^ 1U);
+        }
+    }
+};
+
+template <auto Member> FieldPredicate<Member, COMPARE_LT> field_lt(member_type_t<Member> v) { return { v }; }
+template <auto Member> FieldPredicate<Member, COMPARE_LE> field_le(member_type_t<Member> v) { return { v }; }
+template <auto Member> FieldPredicate<Member, COMPARE_GT> field_gt(member_type_t<Member> v) { return { v }; }
+template <auto Member> FieldPredicate<Member, COMPARE_GE> field_ge(member_type_t<Member> v) { return { v }; }
+template <auto Member> FieldPredicate<Member, COMPARE_EQ> field_eq(member_type_t<Member> v) { return { v }; }
+template <auto Member> FieldPredicate<Member, COMPARE_NE> field_ne(member_type_t<Member> v) { return { v }; }
+
+template <typename Lhs, typename Rhs>
+CombinedPredicate<Lhs, Rhs, true> scan_and(const Lhs& lhs, const Rhs& rhs) { return { lhs, rhs }; }
+template <typename Lhs, typename Rhs>
+CombinedPredicate<Lhs, Rhs, false> scan_or(const Lhs& lhs, const Rhs& rhs) { return { lhs, rhs }; }
+template <typename Inner>
+NotPredicate<Inner> scan_not(const Inner& inner) { return { inner }; }
+
+// ==========================================
+// PREDICATE PUSHDOWN SCAN
+// ==========================================
+
+// Number of the first frame_count frames (every frame_stride bytes) that lie
+// wholly inside frames_len bytes; logs when the caller asked for more.
+inline size_t frames_within(size_t frames_len, size_t frame_stride, size_t frame_size, size_t frame_count) {
+    const size_t available = (frames_len < frame_size) ? 0U : (((frames_len - frame_size) / frame_stride) + 1U);
+    if (frame_count > available) {
+        LOG_ERROR("Buffer holds %zu frames, %zu requested", available, frame_count);
+        return available;
+    }
+    return frame_count;
+}
+
+// Evaluates predicate over frame_count serialized frames laid out every
+// frame_stride bytes and writes matching frame indices. Stops early when
+// match_indices is full; frames_scanned tells the caller where to resume.
+// frame_count is clamped to the frames that fit in frames_len.
+template <typename Predicate>
+size_t scan_frames(const uint8_t* frames, size_t frames_len, size_t frame_stride, size_t frame_count,
+    const Predicate& predicate, uint32_t* match_indices, size_t max_matches, size_t& frames_scanned) {
+    using Layout = wire_layout_t<typename Predicate::frame_type>;
+    size_t matches = 0;
+    frames_scanned = 0;
+
+    if (frame_stride < Layout::size) {
+        LOG_ERROR("Frame stride %zu shorter than packed frame %zu", frame_stride, Layout::size);
+        return 0;
+    }
+    frame_count = frames_within(frames_len, frame_stride, Layout::size, frame_count);
+
+    uint8_t mask[SCAN_BLOCK_FRAMES];
+    size_t base = 0;
+    while ((base < frame_count) && (matches < max_matches)) {
+        const size_t block = std::min(SCAN_BLOCK_FRAMES, frame_count - base);
+        predicate.evaluate(frames + (base * frame_stride), frame_stride, block, mask);
+
+        size_t i = 0;
+        for (; (i < block) && (matches < max_matches); ++i) {
+            if (mask[i] != 0U) {
+                match_indices[matches] = static_cast<uint32_t>(base + i);
+                matches++;
+            }
+        }
+        base += i;
+    }
+    frames_scanned = base;
+    return matches;
+}
+
+// ==========================================
+// FUSED DECODE & AGGREGATE
+// ==========================================
+// Running statistics are merged block by block (Chan et al. parallel
+// variance), so min/max/sum/exceedance loops run over a contiguous block of
+// values and each frame block is pulled into cache once for all fields.
+
+struct FieldStats {
+    double min;
+    double max;
+    double mean;
+    double m2;              // Sum of squared deviations from the mean
+    uint64_t count;         // Finite samples folded into min/max/mean/m2
+    uint64_t exceedances;   // Samples strictly above threshold
+    uint64_t non_finite;    // NaN/Inf samples, skipped by every other statistic
+    double threshold;
+
+    double variance() const {
+        return (count > 1U) ? (m2 / static_cast<double>(count - 1U)) : 0.0;
+    }
+};
+
+inline FieldStats make_field_stats(double threshold = std::numeric_limits<double>::infinity()) {
+    return { std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+        0.0, 0.0, 0U, 0U, 0U, threshold };
+}
+
+inline void merge_block_stats(FieldStats& stats, const double* values, size_t count) {
+    double block_min = std::numeric_limits<double>::infinity();
+    double block_max = -std::numeric_limits<double>::infinity();
+    double block_sum = 0.0;
+    uint64_t block_finite = 0U;
+    uint64_t block_exceed = 0U;
+    for (size_t i = 0; i < count; ++i) {
+        if (!std::isfinite(values[i])) continue;
+        block_min = std::min(block_min, values[i]);
+        block_max = std::max(block_max, values[i]);
+        block_sum += values[i];
+        block_finite++;
+        block_exceed += static_cast<uint64_t>(values[i] > stats.threshold);
+    }
+    stats.non_finite += static_cast<uint64_t>(count) - block_finite;
+    if (block_finite == 0U) return;
+
+    const double block_n = static_cast<double>(block_finite);
+    const double block_mean = block_sum / block_n;
+    double block_m2 = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!std::isfinite(values[i])) continue;
+        const double d = values[i] - block_mean;
+        block_m2 += d * d;
+    }
+
+    const double total_n = static_cast<double>(stats.count) + block_n;
+    const double delta = block_mean - stats.mean;
+    stats.m2 += block_m2 + ((delta * delta) * (static_cast<double>(stats.count) * block_n) / total_n);
+    stats.mean += delta * (block_n / total_n);
+    stats.count += block_finite;
+    stats.min = std::min(stats.min, block_min);
+    stats.max = std::max(stats.max, block_max);
+    stats.exceedances += block_exceed;
+}
+
+template <auto Member>
+void aggregate_field_block(const uint8_t* frames, size_t frame_stride, size_t count, FieldStats& stats) {
+    static_assert(std::is_arithmetic_v<member_type_t<Member>>, "Only arithmetic fields can be aggregated");
+    double values[SCAN_BLOCK_FRAMES];
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<double>(load_wire_field<Member>(frames + (i * frame_stride)));
+    }
+    merge_block_stats(stats, values, count);
+}
+
+template <auto First, auto... Rest>
+struct first_member_class {
+    using type = member_class_t<First>;
+};
+
+// Streams frame_count serialized frames once and folds every listed field
+// into stats (same order as Members). stats accumulates across calls, so a
+// whole flight can be fed chunk by chunk. Fails without touching stats when
+// frame_count frames do not fit in frames_len.
+template <auto... Members>
+bool aggregate_frames(const uint8_t* frames, size_t frames_len, size_t frame_stride, size_t frame_count,
+    std::array<FieldStats, sizeof...(Members)>& stats) {
+    static_assert(sizeof...(Members) > 0, "Select at least one field");
+    using Frame = typename first_member_class<Members...>::type;
+    static_assert((std::is_same_v<member_class_t<Members>, Frame> && ...), "Fields must belong to one frame type");
+
+    if (frame_stride < wire_layout_t<Frame>::size) {
+        LOG_ERROR("Frame stride %zu shorter than packed frame %zu", frame_stride, wire_layout_t<Frame>::size);
+        return false;
+    }
+    // Partial statistics would look complete, so an overstated count is rejected.
+    if (frames_within(frames_len, frame_stride, wire_layout_t<Frame>::size, frame_count) != frame_count) return false;
+
+    for (size_t base = 0; base < frame_count; base += SCAN_BLOCK_FRAMES) {
+        const size_t block = std::min(SCAN_BLOCK_FRAMES, frame_count - base);
+        const uint8_t* block_frames = frames + (base * frame_stride);
+        size_t field = 0;
+        (aggregate_field_block<Members>(block_frames, frame_stride, block, stats[field++]), ...);
+    }
+    return true;
+}
+
+#endif // SAFE_SCAN_H
@@ -0,0 +1,158 @@
+#ifndef SAFE_SCHEMA_H
+#define SAFE_SCHEMA_H
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <type_traits>
+#include "SafeSerializer.h"
+
+// ==========================================
+// SCHEMA HISTORY
+// ==========================================
+// A schema only evolves by appending fields at the tail of its wire_layout or
+// by deprecating fields in place, so every revision is a prefix of the
+// current layout. Specialize per struct:
+//
+//   template <> struct schema_history<T> {
+//       static constexpr auto version_field = &T::version;
+//       static constexpr uint8_t current_version = 3;
+//       static constexpr std::array<SchemaRevision, N> revisions = { ... };    // older only
+//       static constexpr std::array<DeprecatedField, M> deprecated = { ... };
+//   };
+
+struct SchemaRevision {
+    uint8_t version;
+    size_t field_count;     // Leading wire_layout fields present in this revision
+};
+
+struct DeprecatedField {
+    size_t field_index;     // wire_layout index; the bytes stay on the wire
+    uint8_t since_version;  // Decoded as value-initialized from this version on
+};
+
+template <typename T>
+struct schema_history;
+
+// ==========================================
+// TABLE-DRIVEN FIELD CODECS
+// ==========================================
+
+template <typename T>
+struct FieldCodec {
+    bool (*decode)(T& obj, const uint8_t* buffer, size_t buffer_len, size_t& offset);
+    void (*clear)(T& obj);
+};
+
+template <auto Member>
+bool decode_member(member_class_t<Member>& obj, const uint8_t* buffer, size_t buffer_len, size_t& offset) {
+    return deserialize_from_buffer(buffer, buffer_len, offset, obj.*Member);
+}
+
+template <auto Member>
+void clear_member(member_class_t<Member>& obj) {
+    obj.*Member = member_type_t<Member>{};
+}
+
+template <typename T, typename Layout>
+struct field_codec_table;
+template <typename T, auto... Members>
+struct field_codec_table<T, PackedLayout<Members...>> {
+    static constexpr std::array<FieldCodec<T>, sizeof...(Members)> codecs = {
+        FieldCodec<T>{ &decode_member<Members>, &clear_member<Members> }...
+    };
+};
+
+// ==========================================
+// VERSIONED DESERIALIZATION
+// ==========================================
+
+// Every revision must cover the version field and fit inside the current layout.
+template <typename T>
+constexpr bool schema_history_valid() {
+    using History = schema_history<T>;
+    using Layout = wire_layout_t<T>;
+    constexpr size_t version_index = Layout::template index_of<History::version_field>();
+    for (const SchemaRevision& revision : History::revisions) {
+        if ((revision.field_count > Layout::field_count) || (revision.field_count <= version_index)) return false;
+        if (revision.version == History::current_version) return false;
+    }
+    for (const DeprecatedField& field : History::deprecated) {
+        if (field.field_index >= Layout::field_count) return false;
+    }
+    return true;
+}
+
+template <typename T>
+void clear_deprecated_fields(T& obj, uint8_t version) {
+    using History = schema_history<T>;
+    constexpr auto& codecs = field_codec_table<T, wire_layout_t<T>>::codecs;
+    for (const DeprecatedField& field : History::deprecated) {
+        if (version >= field.since_version) codecs[field.field_index].clear(obj);
+    }
+}
+
+// Current-version frames go through T::deserialize (straight-line fold);
+// only older revisions walk the codec table, and missing tail fields are
+// value-initialized. Newer frames extend the current layout, but their
+// length is unknown to this build, so they are decoded only when the
+// container supplies frame_len (recorder index, datagram size): the current
+// prefix is decoded and the unknown tail skipped. Without it they are
+// rejected, so a back-to-back recording never loses the frames after one.
+template <typename T>
+bool deserialize_versioned(T& obj, const uint8_t* buffer, size_t buffer_len, size_t& consumed,
+    size_t frame_len = 0U) {
+    using History = schema_history<T>;
+    using Codecs = field_codec_table<T, wire_layout_t<T>>;
+    constexpr auto version_field = History::version_field;
+    static_assert(std::is_same_v<member_class_t<version_field>, T>, "Version field must belong to T");
+    static_assert(schema_history_valid<T>(), "Inconsistent schema_history");
+
+    member_type_t<version_field> version{};
+    if (!peek_field<version_field>(buffer, buffer_len, version)) return false;
+    const uint8_t wire_version = static_cast<uint8_t>(version);
+
+    if (wire_version > History::current_version) {
+        if (frame_len == 0U) {
+            LOG_ERROR("Schema version %u newer than %u and frame length unknown",
+                static_cast<unsigned int>(wire_version), static_cast<unsigned int>(History::current_version));
+            return false;
+        }
+        if ((frame_len < wire_layout_t<T>::size) || (frame_len > buffer_len)) {
+            LOG_ERROR("Frame length %zu invalid (layout %zu, buffer %zu)", frame_len, wire_layout_t<T>::size, buffer_len);
+            return false;
+        }
+        size_t prefix_consumed = 0;
+        if (!obj.deserialize(buffer, frame_len, prefix_consumed)) return false;
+        if constexpr (History::deprecated.size() != 0U) clear_deprecated_fields(obj, wire_version);
+        consumed = frame_len;
+        return true;
+    }
+
+    if (wire_version == History::current_version) {
+        consumed = 0;
+        if (!obj.deserialize(buffer, buffer_len, consumed)) return false;
+        if constexpr (History::deprecated.size() != 0U) clear_deprecated_fields(obj, wire_version);
+        return true;
+    }
+
+    const SchemaRevision* revision = nullptr;
+    for (const SchemaRevision& candidate : History::revisions) {
+        if (candidate.version == wire_version) revision = &candidate;
+    }
+    if (revision == nullptr) {
+        LOG_ERROR("Unsupported schema version %u", static_cast<unsigned int>(wire_version));
+        return false;
+    }
+
+    obj = T{};
+    size_t offset = 0;
+    for (size_t i = 0; i < revision->field_count; ++i) {
+        if (!Codecs::codecs[i].decode(obj, buffer, buffer_len, offset)) return false;
+    }
+    clear_deprecated_fields(obj, wire_version);
+    consumed = offset;
+    return true;
+}
+
+#endif // SAFE_SCHEMA_H
@@ -10,6 +10,7 @@
 #include <type_traits>
 #include <cstring>
 #include <array>
+#include <cmath>
 #include "DebugUtils.h"
 
 
@@ -89,6 +90,109 @@ void safe_write_to_buffer(uint8_t* dest, const T& src) {
     std::copy(src_ptr, src_ptr + sizeof(T), dest);
 }
 
+// ==========================================
+// MEMBER POINTER TRAITS & WIRE LAYOUT DECLARATION
+// ==========================================
+
+template <typename T>
+struct member_pointer_traits;
+template <typename C, typename M>
+struct member_pointer_traits<M C::*> {
+    using class_type = C;
+    using member_type = M;
+};
+
+template <auto Member>
+using member_type_t = typename member_pointer_traits<std::remove_cv_t<decltype(Member)>>::member_type;
+template <auto Member>
+using member_class_t = typename member_pointer_traits<std::remove_cv_t<decltype(Member)>>::class_type;
+
+// Specialize per struct as PackedLayout<&T::a, &T::b, ...> in wire order;
+// PackedLayout::serialize()/deserialize() then encode exactly that order.
+template <typename T>
+struct wire_layout;
+
+// SFINAE Check
+template <typename T, typename = void>
+struct has_wire_layout : std::false_type {};
+template <typename T>
+struct has_wire_layout<T, std::void_t<typename wire_layout<T>::type>> : std::true_type {};
+
+template <typename T>
+using wire_layout_t = typename wire_layout<T>::type;
+
+// ==========================================
+// FIELD VALIDATION HOOKS
+// ==========================================
+// Specialize per member to declare its valid (inclusive) range:
+//
+//   template <> struct field_range<&T::latitude_deg> {
+//       static constexpr bool enabled = true;
+//       static constexpr double min_value = -90.0;
+//       static constexpr double max_value = 90.0;
+//   };
+//
+// The ranges are only consulted for fields passed to deserialize_from_buffer
+// wrapped in a CheckedField (see PackedLayout::deserialize); plain decodes
+// never look them up.
+
+template <auto Member>
+struct field_range {
+    static constexpr bool enabled = false;
+    static constexpr double min_value = 0.0;
+    static constexpr double max_value = 0.0;
+};
+
+enum NanPolicy_e : uint8_t {
+    NAN_POLICY_REJECT = 0,  // NaN/Inf in any float field is a violation
+    NAN_POLICY_ALLOW = 1
+};
+
+struct DecodeCheck {
+    NanPolicy_e nan_policy;
+    uint64_t* violations;   // One bit per field of the layout being decoded
+    size_t violation_count;
+};
+
+inline void flag_violation(DecodeCheck& check, size_t index) {
+    check.violations[index / 64U] |= (uint64_t{ 1 } << (index % 64U));
+    check.violation_count++;
+}
+
+// A member reference tagged with its member pointer, so the decode fold can
+// look up field_range<Member> right after the byte swap.
+template <auto Member>
+struct CheckedField {
+    static constexpr auto member = Member;
+    member_type_t<Member>& value;
+    DecodeCheck& check;
+    size_t index;
+};
+
+template <typename T>
+struct is_checked_field : std::false_type {};
+template <auto Member>
+struct is_checked_field<CheckedField<Member>> : std::true_type {};
+
+template <typename T>
+T& checked_field_value(T& field) { return field; }
+template <auto Member>
+member_type_t<Member>& checked_field_value(CheckedField<Member>& field) { return field.value; }
+
+template <auto Member>
+bool field_value_valid(const member_type_t<Member>& value, NanPolicy_e policy) {
+    using T = member_type_t<Member>;
+    bool valid = true;
+    if constexpr (std::is_floating_point_v<T>) {
+        valid = (policy == NAN_POLICY_ALLOW) || std::isfinite(value);
+    }
+    if constexpr (field_range<Member>::enabled) {
+        const double v = static_cast<double>(value);
+        valid = valid && (v >= field_range<Member>::min_value) && (v <= field_range<Member>::max_value);
+    }
+    return valid;
+}
+
 // ==========================================
 // DESERIALIZATION TRAITS & ENGINE
 // ==========================================
@@ -99,14 +203,22 @@ struct has_deserialize : std::false_type {};
 template <typename T>
 struct has_deserialize < T, std::void_t<decltype(std::declval<T>().deserialize(std::declval<const uint8_t*>(), size_t{}, std::declval<size_t&>())) >> : std::true_type {};
 
+// Fields may be plain lvalues or CheckedField wrappers; wrapped fields are
+// validated in the same pass and violations recorded in their DecodeCheck.
 template <typename... Args>
-bool deserialize_from_buffer(const uint8_t* buffer, size_t buffer_len, size_t& offset, Args&... args) {
+bool deserialize_from_buffer(const uint8_t* buffer, size_t buffer_len, size_t& offset, Args&&... args) {
+    // Forwarding references exist only for CheckedField temporaries; a plain
+    // rvalue would decode into a discarded copy and still report success.
+    static_assert(((std::is_lvalue_reference_v<Args> || is_checked_field<std::decay_t<Args>>::value) && ...),
+        "deserialize_from_buffer needs lvalue fields (or CheckedField wrappers)");
     bool global_success = true;
     int field_index = 0;
 
-    auto process_field = [&](auto& field) {
+    auto process_field = [&](auto& arg) {
         if (!global_success) return;
         field_index++;
+        using Arg = std::decay_t<decltype(arg)>;
+        auto& field = checked_field_value(arg);
         using T = std::decay_t<decltype(field)>;
 
 #ifdef TEST_ENV
@@ -122,7 +234,17 @@ bool deserialize_from_buffer(const uint8_t* buffer, size_t buffer_len, size_t& o
             if (offset >= buffer_len) {
                 global_success = false; return;
             }
-            bool sub_result = field.deserialize(buffer + offset, buffer_len - offset, sub_consumed);
+            bool sub_result = false;
+            if constexpr (is_checked_field<Arg>::value && has_wire_layout<T>::value) {
+                // Nested layouts are checked field by field and reported on the parent field.
+                uint64_t nested_bits[(wire_layout_t<T>::field_count + 63U) / 64U] = {};
+                DecodeCheck nested = { arg.check.nan_policy, nested_bits, 0U };
+                sub_result = wire_layout_t<T>::deserialize(field, buffer + offset, buffer_len - offset, sub_consumed, &nested);
+                if (sub_result && (nested.violation_count != 0U)) flag_violation(arg.check, arg.index);
+            }
+            else {
+                sub_result = field.deserialize(buffer + offset, buffer_len - offset, sub_consumed);
+            }
             if (!sub_result) global_success = false;
             else {
                 offset += sub_consumed;
@@ -139,6 +261,9 @@ bool deserialize_from_buffer(const uint8_t* buffer, size_t buffer_len, size_t& o
             }
             safe_read_from_buffer(field, buffer + offset);
             field = safe_ntoh(field); // Endianness swap
+            if constexpr (is_checked_field<Arg>::value) {
+                if (!field_value_valid<Arg::member>(field, arg.check.nan_policy)) flag_violation(arg.check, arg.index);
+            }
 #ifdef TEST_ENV
             std::printf(" Val: "); print_debug_value(field); std::printf("\n");
 #endif
@@ -245,4 +370,128 @@ constexpr size_t calculate_packed_size(const Args&... args) {
     return total_size;
 }
 
+// ==========================================
+// PACKED LAYOUT ENGINE (Compile-Time Offsets)
+// ==========================================
+
+template <typename T>
+constexpr size_t packed_size_of() {
+    if constexpr (has_wire_layout<T>::value) return wire_layout<T>::type::size;
+    else return sizeof(T);
+}
+
+template <auto A, auto B>
+constexpr bool is_same_member() {
+    if constexpr (std::is_same_v<decltype(A), decltype(B)>) return A == B;
+    else return false;
+}
+
+// Fixed-size wire member: a scalar/enum or a nested struct with its own layout.
+template <typename T>
+constexpr bool is_fixed_wire_member() {
+    return has_wire_layout<T>::value || !has_deserialize<T>::value;
+}
+
+template <auto... Members>
+struct PackedLayout {
+    static_assert((is_fixed_wire_member<member_type_t<Members>>() && ...),
+        "Variable-length members have no packed offset; keep them out of wire layouts");
+
+    static constexpr size_t field_count = sizeof...(Members);
+    static constexpr size_t size = (size_t{ 0 } + ... + packed_size_of<member_type_t<Members>>());
+
+    // Codec entry points: structs with a layout implement serialize()/deserialize()
+    // through these so the member list above is the only copy of the field order.
+    // With a DecodeCheck every member goes through the same fold wrapped in a
+    // CheckedField, so it is validated right after its byte swap.
+    template <typename T>
+    static bool deserialize(T& obj, const uint8_t* buffer, size_t buffer_len, size_t& offset,
+        DecodeCheck* check = nullptr) {
+        if (check == nullptr) return deserialize_from_buffer(buffer, buffer_len, offset, (obj.*Members)...);
+        return deserialize_from_buffer(buffer, buffer_len, offset,
+            CheckedField<Members>{ obj.*Members, *check, index_of<Members>() }...);
+    }
+
+    template <typename T>
+    static bool serialize(const T& obj, uint8_t* buffer, size_t buffer_len, size_t& offset) {
+        return serialize_to_buffer(buffer, buffer_len, offset, (obj.*Members)...);
+    }
+
+    // Returns field_count when Member is not part of the layout.
+    template <auto Member>
+    static constexpr size_t index_of() {
+        size_t index = 0;
+        bool found = false;
+        auto step = [&](bool match) {
+            if (match) found = true;
+            if (!found) index++;
+            };
+        (step(is_same_member<Members, Member>()), ...);
+        return index;
+    }
+
+    template <auto Member>
+    static constexpr size_t offset_of() {
+        static_assert(index_of<Member>() < field_count, "Member is not part of this wire layout");
+        size_t offset = 0;
+        bool found = false;
+        auto step = [&](bool match, size_t field_size) {
+            if (match) found = true;
+            if (!found) offset += field_size;
+            };
+        (step(is_same_member<Members, Member>(), packed_size_of<member_type_t<Members>>()), ...);
+        return offset;
+    }
+
+    // Visitor receives (std::integral_constant<decltype(Member), Member>, wire offset).
+    template <typename Visitor>
+    static void for_each_field(Visitor&& visitor) {
+        size_t offset = 0;
+        ((visitor(std::integral_constant<decltype(Members), Members>{}, offset),
+            offset += packed_size_of<member_type_t<Members>>()), ...);
+    }
+};
+
+// ==========================================
+// IN-PLACE FIELD ACCESS (Serialized Frames)
+// ==========================================
+
+// Overwrites a single field of an already-serialized frame at its packed
+// offset. Only the bytes up to the end of that field need to be present, so
+// truncated (older-revision) frames can be patched too.
+template <auto Member>
+bool patch_field(uint8_t* buffer, size_t buffer_len, const member_type_t<Member>& value) {
+    using Layout = wire_layout_t<member_class_t<Member>>;
+    constexpr size_t offset = Layout::template offset_of<Member>();
+    constexpr size_t needed = packed_size_of<member_type_t<Member>>();
+
+    if (buffer_len < offset + needed) {
+        LOG_ERROR("Patch target too short! Need %zu, Has %zu", offset + needed, buffer_len);
+        return false;
+    }
+    size_t cursor = offset;
+    return serialize_to_buffer(buffer, offset + needed, cursor, value);
+}
+
+// patch_fields<&T::a, &T::b>(buffer, len, a, b): stops at the first failure.
+template <auto... Members>
+bool patch_fields(uint8_t* buffer, size_t buffer_len, const member_type_t<Members>&... values) {
+    return (patch_field<Members>(buffer, buffer_len, values) && ...);
+}
+
+// Reads a single field of a serialized frame without decoding the rest.
+template <auto Member>
+bool peek_field(const uint8_t* buffer, size_t buffer_len, member_type_t<Member>& value) {
+    using Layout = wire_layout_t<member_class_t<Member>>;
+    constexpr size_t offset = Layout::template offset_of<Member>();
+    constexpr size_t needed = packed_size_of<member_type_t<Member>>();
+
+    if (buffer_len < offset + needed) {
+        LOG_ERROR("Buffer Underrun! Need %zu, Has %zu", offset + needed, buffer_len);
+        return false;
+    }
+    size_t cursor = offset;
+    return deserialize_from_buffer(buffer, offset + needed, cursor, value);
+}
+
 #endif // SAFE_SERIALIZER_H
\ No newline at end of file
@@ -0,0 +1,255 @@
+#ifndef SAFE_TRANSPORT_H
+#define SAFE_TRANSPORT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include "SafeSerializer.h"
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+// ==========================================
+// BATCHED DATAGRAM TRANSPORT (Linux)
+// ==========================================
+// One datagram per frame, BatchSize datagrams per sendmmsg/recvmmsg call.
+// Frames are serialized straight into fixed slots that the mmsghdr vector
+// already points at, and received frames are decoded in place from those
+// slots. The slots make this object large: keep it static or on the heap.
+
+template <size_t BatchSize, size_t SlotSize>
+class BatchDatagramSocket {
+    static_assert(BatchSize > 0U, "Batch must hold at least one frame");
+
+public:
+    BatchDatagramSocket() : fd_(-1) {
+        for (size_t i = 0; i < BatchSize; ++i) {
+            iov_[i].iov_base = slots_[i];
+            iov_[i].iov_len = SlotSize;
+        }
+        reset_headers(BatchSize);
+    }
+
+    ~BatchDatagramSocket() { close(); }
+
+    BatchDatagramSocket(const BatchDatagramSocket&) = delete;
+    BatchDatagramSocket& operator=(const BatchDatagramSocket&) = delete;
+
+    // Replaces a stale socket left at path; anything else there is left
+    // alone and bind() reports EADDRINUSE.
+    bool bind_unix(const char* path) {
+        sockaddr_un addr = {};
+        if (!make_unix_address(path, addr) || !open_socket(AF_UNIX)) return false;
+        struct stat existing = {};
+        if ((::lstat(path, &existing) == 0) && S_ISSOCK(existing.st_mode)) ::unlink(path);
+        return check(::bind(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)), "bind");
+    }
+
+    bool connect_unix(const char* path) {
+        sockaddr_un addr = {};
+        if (!make_unix_address(path, addr) || !open_socket(AF_UNIX)) return false;
+        return check(::connect(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)), "connect");
+    }
+
+    bool bind_udp_loopback(uint16_t port) {
+        const sockaddr_in addr = make_loopback_address(port);
+        if (!open_socket(AF_INET)) return false;
+        return check(::bind(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)), "bind");
+    }
+
+    bool connect_udp_loopback(uint16_t port) {
+        const sockaddr_in addr = make_loopback_address(port);
+        if (!open_socket(AF_INET)) return false;
+        return check(::connect(fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)), "connect");
+    }
+
+    // Connected Unix-domain datagram pair, for in-process links and tests.
+    static bool open_pair(BatchDatagramSocket& first, BatchDatagramSocket& second) {
+        int fds[2] = { -1, -1 };
+        if (::socketpair(AF_UNIX, SOCK_DGRAM, 0, fds) != 0) {
+            LOG_ERROR("socketpair failed (errno=%d)", errno);
+            return false;
+        }
+        first.close();
+        second.close();
+        first.fd_ = fds[0];
+        second.fd_ = fds[1];
+        return true;
+    }
+
+    void close() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int native_handle() const { return fd_; }
+
+    // Serializes and sends count frames, BatchSize per syscall. Returns the
+    // number of frames handed to the kernel.
+    template <typename T>
+    size_t send_batch(const T* frames, size_t count) {
+        size_t sent = 0;
+        while (sent < count) {
+            const size_t batch = std::min(BatchSize, count - sent);
+            for (size_t i = 0; i < batch; ++i) {
+                size_t consumed = 0;
+                if (!frames[sent + i].serialize(slots_[i], SlotSize, consumed)) {
+                    LOG_ERROR("Frame %zu does not fit a %zu byte slot", sent + i, SlotSize);
+                    return sent;
+                }
+                iov_[i].iov_base = slots_[i];
+                iov_[i].iov_len = consumed;
+            }
+            reset_headers(batch);
+            const size_t pushed = send_headers(batch);
+            sent += pushed;
+            if (pushed < batch) break;
+        }
+        return sent;
+    }
+
+    // Sends already-serialized frames laid out every frame_stride bytes. The
+    // iovecs point into frames directly, so nothing is copied.
+    size_t send_wire_batch(const uint8_t* frames, size_t frame_stride, size_t frame_size, size_t count) {
+        size_t sent = 0;
+        while (sent < count) {
+            const size_t batch = std::min(BatchSize, count - sent);
+            for (size_t i = 0; i < batch; ++i) {
+                iov_[i].iov_base = const_cast<uint8_t*>(frames + ((sent + i) * frame_stride));
+                iov_[i].iov_len = frame_size;
+            }
+            reset_headers(batch);
+            const size_t pushed = send_headers(batch);
+            sent += pushed;
+            if (pushed < batch) break;
+        }
+        return sent;
+    }
+
+    // Receives up to max_frames datagrams with one recvmmsg and decodes each
+    // in place. Truncated or undecodable datagrams are dropped. Pass
+    // MSG_DONTWAIT in flags for a non-blocking poll.
+    template <typename T>
+    size_t receive_batch(T* frames, size_t max_frames, int flags = 0) {
+        const size_t received = receive_raw(std::min(BatchSize, max_frames), flags);
+        size_t decoded = 0;
+        for (size_t i = 0; i < received; ++i) {
+            size_t consumed = 0;
+            if (!frames[decoded].deserialize(slots_[i], msgs_[i].msg_len, consumed)) {
+                LOG_ERROR("Dropping undecodable datagram %zu (%u bytes)", i, msgs_[i].msg_len);
+                continue;
+            }
+            decoded++;
+        }
+        return decoded;
+    }
+
+    // Receives into the slots without decoding; read them back with
+    // slot()/slot_length(). Truncated datagrams get length 0.
+    size_t receive_raw(size_t max_frames, int flags = 0) {
+        const size_t batch = std::min(BatchSize, max_frames);
+        for (size_t i = 0; i < batch; ++i) {
+            iov_[i].iov_base = slots_[i];
+            iov_[i].iov_len = SlotSize;
+        }
+        reset_headers(batch);
+
+        int result = -1;
+        do {
+            result = ::recvmmsg(fd_, msgs_, static_cast<unsigned int>(batch), flags, nullptr);
+        } while ((result < 0) && (errno == EINTR));
+
+        if (result < 0) {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) LOG_ERROR("recvmmsg failed (errno=%d)", errno);
+            return 0;
+        }
+        for (int i = 0; i < result; ++i) {
+            if ((msgs_[i].msg_hdr.msg_flags & MSG_TRUNC) != 0) {
+                LOG_ERROR("Datagram %d truncated to %zu byte slot", i, SlotSize);
+                msgs_[i].msg_len = 0;
+            }
+        }
+        return static_cast<size_t>(result);
+    }
+
+    const uint8_t* slot(size_t index) const { return slots_[index]; }
+    size_t slot_length(size_t index) const { return msgs_[index].msg_len; }
+
+private:
+    void reset_headers(size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            std::memset(&msgs_[i], 0, sizeof(msgs_[i]));
+            msgs_[i].msg_hdr.msg_iov = &iov_[i];
+            msgs_[i].msg_hdr.msg_iovlen = 1;
+        }
+    }
+
+    size_t send_headers(size_t count) {
+        size_t pushed = 0;
+        while (pushed < count) {
+            const int result = ::sendmmsg(fd_, msgs_ + pushed, static_cast<unsigned int>(count - pushed), 0);
+            if (result < 0) {
+                if (errno == EINTR) continue;
+                LOG_ERROR("sendmmsg failed (errno=%d)", errno);
+                break;
+            }
+            pushed += static_cast<size_t>(result);
+        }
+        return pushed;
+    }
+
+    bool open_socket(int domain) {
+        close();
+        fd_ = ::socket(domain, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        return check(fd_, "socket");
+    }
+
+    bool check(int result, const char* operation) {
+        if (result < 0) {
+            LOG_ERROR("%s failed (errno=%d)", operation, errno);
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    static bool make_unix_address(const char* path, sockaddr_un& addr) {
+        const size_t length = std::strlen(path);
+        if (length >= sizeof(addr.sun_path)) {
+            LOG_ERROR("Socket path too long (%zu bytes)", length);
+            return false;
+        }
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path, length + 1U);
+        return true;
+    }
+
+    static sockaddr_in make_loopback_address(uint16_t port) {
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return addr;
+    }
+
+    int fd_;
+    alignas(64) uint8_t slots_[BatchSize][SlotSize];
+    iovec iov_[BatchSize];
+    mmsghdr msgs_[BatchSize];
+};
+
+#endif // __linux__
+
+#endif // SAFE_TRANSPORT_H
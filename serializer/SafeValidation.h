@@ -0,0 +1,52 @@
+#ifndef SAFE_VALIDATION_H
+#define SAFE_VALIDATION_H
+
+#include <cstdint>
+#include <cstddef>
+#include <bitset>
+#include "SafeSerializer.h"
+
+// ==========================================
+// VALIDATED DESERIALIZATION
+// ==========================================
+// field_range<&T::member> specializations (SafeSerializer.h) declare the
+// valid ranges. Validation is not a second decoder: deserialize_validated
+// hands a DecodeCheck to PackedLayout::deserialize, which runs the usual
+// deserialize_from_buffer fold with each member wrapped in a CheckedField,
+// so every field is checked right after its byte swap.
+
+template <typename T>
+struct ValidationReport {
+    std::bitset<wire_layout_t<T>::field_count> violations;  // Indexed by wire_layout field
+};
+
+// Decodes a packed frame and validates it in the same pass. Returns false
+// only when the buffer is too short; inspect report.violations for ranges.
+// Nested structs report on their parent field.
+template <typename T>
+bool deserialize_validated(T& obj, const uint8_t* buffer, size_t buffer_len, size_t& consumed,
+    ValidationReport<T>& report, NanPolicy_e policy = NAN_POLICY_REJECT) {
+    using Layout = wire_layout_t<T>;
+    report.violations.reset();
+
+    if (buffer_len < Layout::size) {
+        LOG_ERROR("Buffer Underrun! Need %zu, Has %zu", Layout::size, buffer_len);
+        return false;
+    }
+
+    uint64_t violation_bits[(Layout::field_count + 63U) / 64U] = {};
+    DecodeCheck check = { policy, violation_bits, 0U };
+    size_t offset = 0;
+    if (!Layout::deserialize(obj, buffer, buffer_len, offset, &check)) return false;
+
+    if (check.violation_count != 0U) {
+        for (size_t i = 0; i < Layout::field_count; ++i) {
+            report.violations[i] = ((violation_bits[i / 64U] >> (i % 64U)) & 1U) != 0U;
+        }
+        LOG_ERROR("Validation failed on %zu field(s)", check.violation_count);
+    }
+    consumed = offset;
+    return true;
+}
+
+#endif // SAFE_VALIDATION_H
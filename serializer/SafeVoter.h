@@ -0,0 +1,152 @@
+#ifndef SAFE_VOTER_H
+#define SAFE_VOTER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <type_traits>
+#include "SafeSerializer.h"
+
+// ==========================================
+// TRIPLE-REDUNDANT CHANNEL VOTER
+// ==========================================
+// Votes three serialized copies of the same frame into one voted wire frame
+// without deserializing them. The common case (all channels identical) is a
+// pair of whole-frame memcmp calls, which the C library runs with SIMD; only
+// when they differ does the voter walk the packed layout field by field:
+//   - integers, enums, bools: 2-of-3 majority on the wire bytes
+//   - float, double: median of the finite channels, flagged when no other
+//     channel lies within tolerance of it
+//   - nested structs: voted recursively, reported on the parent field
+
+struct VoteOutcome {
+    bool disagreement;  // Channels were not all identical
+    bool unresolved;    // No majority / fewer than two usable channels
+};
+
+template <typename T>
+struct VoteReport {
+    std::bitset<wire_layout_t<T>::field_count> disagreement;
+    std::bitset<wire_layout_t<T>::field_count> unresolved;
+};
+
+template <typename T>
+VoteOutcome vote_float_field(const uint8_t* a, const uint8_t* b, const uint8_t* c, uint8_t* out, double tolerance) {
+    T values[3];
+    const uint8_t* channels[3] = { a, b, c };
+    size_t finite = 0;
+    for (const uint8_t* channel : channels) {
+        T value;
+        safe_read_from_buffer(value, channel);
+        value = safe_ntoh(value);
+        if (std::isfinite(value)) {
+            values[finite] = value;
+            finite++;
+        }
+    }
+
+    VoteOutcome outcome = { true, false };
+    T voted = T{};
+    if (finite == 3U) {
+        voted = std::max(std::min(values[0], values[1]), std::min(std::max(values[0], values[1]), values[2]));
+        // Resolved as long as at least one other channel backs the median.
+        const T low = std::min({ values[0], values[1], values[2] });
+        const T high = std::max({ values[0], values[1], values[2] });
+        outcome.unresolved = (static_cast<double>(voted - low) > tolerance) &&
+            (static_cast<double>(high - voted) > tolerance);
+    }
+    else if (finite == 2U) {
+        voted = (values[0] + values[1]) / static_cast<T>(2);
+        outcome.unresolved = static_cast<double>(std::fabs(values[0] - values[1])) > tolerance;
+    }
+    else if (finite == 1U) {
+        // The only healthy channel wins, but one channel is not a vote.
+        voted = values[0];
+        outcome.unresolved = true;
+    }
+    else {
+        // No healthy channel: pass channel A through, flagged.
+        std::copy(a, a + sizeof(T), out);
+        outcome.unresolved = true;
+        return outcome;
+    }
+    safe_write_to_buffer(out, safe_hton(voted));
+    return outcome;
+}
+
+inline VoteOutcome vote_bytes_field(const uint8_t* a, const uint8_t* b, const uint8_t* c, uint8_t* out, size_t size) {
+    VoteOutcome outcome = { true, false };
+    if ((std::memcmp(a, b, size) == 0) || (std::memcmp(a, c, size) == 0)) {
+        std::copy(a, a + size, out);
+    }
+    else if (std::memcmp(b, c, size) == 0) {
+        std::copy(b, b + size, out);
+    }
+    else {
+        std::copy(a, a + size, out);
+        outcome.unresolved = true;
+    }
+    return outcome;
+}
+
+template <typename Frame, typename Report>
+void vote_layout_fields(const uint8_t* a, const uint8_t* b, const uint8_t* c, uint8_t* out, double tolerance,
+    Report* report, VoteOutcome& summary) {
+    size_t index = 0;
+    wire_layout_t<Frame>::for_each_field([&](auto member, size_t offset) {
+        using FieldT = member_type_t<decltype(member)::value>;
+        constexpr size_t size = packed_size_of<FieldT>();
+        VoteOutcome outcome = { false, false };
+
+        if ((std::memcmp(a + offset, b + offset, size) == 0) && (std::memcmp(b + offset, c + offset, size) == 0)) {
+            std::copy(a + offset, a + offset + size, out + offset);
+        }
+        else if constexpr (has_wire_layout<FieldT>::value) {
+            vote_layout_fields<FieldT, VoteReport<FieldT>>(a + offset, b + offset, c + offset, out + offset,
+                tolerance, nullptr, outcome);
+        }
+        else if constexpr (std::is_floating_point_v<FieldT>) {
+            outcome = vote_float_field<FieldT>(a + offset, b + offset, c + offset, out + offset, tolerance);
+        }
+        else {
+            outcome = vote_bytes_field(a + offset, b + offset, c + offset, out + offset, size);
+        }
+
+        if (report != nullptr) {
+            report->disagreement[index] = outcome.disagreement;
+            report->unresolved[index] = outcome.unresolved;
+        }
+        summary.disagreement = summary.disagreement || outcome.disagreement;
+        summary.unresolved = summary.unresolved || outcome.unresolved;
+        index++;
+        });
+}
+
+// Writes the voted frame to out (which may alias none of the inputs).
+// Returns false only on undersized buffers; per-field problems are reported.
+template <typename T>
+bool vote_frames(const uint8_t* channel_a, const uint8_t* channel_b, const uint8_t* channel_c, size_t frame_len,
+    uint8_t* out, size_t out_len, double tolerance, VoteReport<T>& report) {
+    constexpr size_t frame_size = wire_layout_t<T>::size;
+    report.disagreement.reset();
+    report.unresolved.reset();
+
+    if ((frame_len < frame_size) || (out_len < frame_size)) {
+        LOG_ERROR("Vote buffers shorter than packed frame %zu", frame_size);
+        return false;
+    }
+
+    if ((std::memcmp(channel_a, channel_b, frame_size) == 0) && (std::memcmp(channel_b, channel_c, frame_size) == 0)) {
+        std::copy(channel_a, channel_a + frame_size, out);
+        return true;
+    }
+
+    VoteOutcome summary = { false, false };
+    vote_layout_fields<T>(channel_a, channel_b, channel_c, out, tolerance, &report, summary);
+    return true;
+}
+
+#endif // SAFE_VOTER_H
@@ -1,11 +1,25 @@
 ﻿
 #include "SafeSerializer.h"
+#include "SafeArena.h"
+#include "MessageRegistry.h"
+#include "SafeSchema.h"
+#include "SafeScan.h"
+#include "SafeVoter.h"
+#include "SafeValidation.h"
+#include "SafeTransport.h"
+#include "SafeReplay.h"
+#include "SafeAsync.h"
+#include "SafeBufferPool.h"
 
 #include <cstdint>
 #include <cstddef>
 #include <algorithm>
 #include <type_traits>
 #include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
 
 
 // ==========================================
@@ -17,33 +31,40 @@ enum SystemHealth_e : uint8_t { SYSTEM_STATUS_OK = 0, SYSTEM_STATUS_FAIL = 2 };
 enum NavSource_e : uint8_t { NAV_SOURCE_GPS = 0 };
 enum GearStatus_e : uint8_t { GEAR_UP_LOCKED = 0 };
 
+// Wire schema of DO178C_FlightData_t; bumped only when the frame layout changes.
+constexpr uint8_t FLIGHT_SCHEMA_VERSION = 1;
+
 struct SubSystemData {
     uint16_t subId;
     float temperature;
 
+    // Field order comes from wire_layout<SubSystemData> (see WIRE LAYOUTS).
+    bool deserialize(const uint8_t* buffer, size_t max_len, size_t& consumed);
+    bool serialize(uint8_t* buffer, size_t max_len, size_t& consumed) const;
+    size_t trueSize() const;
+};
+
+// Variable-length maintenance record; the readings live in the decode arena.
+struct MaintenanceLog_t {
+    uint16_t aircraft_id;
+    ArenaArray<float> exceedance_values;
+
     bool deserialize(const uint8_t* buffer, size_t max_len, size_t& consumed) {
         size_t local_offset = 0;
-        // For a nested call, the offset is reset (from the child buffer perspective) or the main buffer is passed.
-        // In this structure, we use the main buffer + offset pointer logic, so local_offset starts at 0 here,
-        // because the pointer is already offset.
-        bool res = deserialize_from_buffer(buffer, max_len, local_offset, subId, temperature);
+        bool res = deserialize_from_buffer(buffer, max_len, local_offset, aircraft_id, exceedance_values);
         consumed = local_offset;
         return res;
     }
 
     bool serialize(uint8_t* buffer, size_t max_len, size_t& consumed) const {
         size_t local_offset = 0;
-        // For a nested call, the offset is reset (from the child buffer perspective) or the main buffer is passed.
-        // In this structure, we use the main buffer + offset pointer logic, so local_offset starts at 0 here,
-        // because the pointer is already offset.
-        bool res = serialize_to_buffer(buffer, max_len, local_offset, subId, temperature);
+        bool res = serialize_to_buffer(buffer, max_len, local_offset, aircraft_id, exceedance_values);
         consumed = local_offset;
         return res;
     }
 
     size_t trueSize() const {
-        // Ignores padding: returns sizeof(uint16_t) + sizeof(uint8_t) = 3.
-		return calculate_packed_size(subId, temperature);
+        return calculate_packed_size(aircraft_id, exceedance_values);
     }
 };
 
@@ -54,6 +75,7 @@ struct DO178C_FlightData_t {
     uint16_t    aircraft_id;
     uint8_t     software_version_major;
     uint8_t     software_version_minor;
+    uint8_t     schema_version = FLIGHT_SCHEMA_VERSION;
 
     // --- SYSTEM STATE & FLAGS ---
     FlightPhase_e current_flight_phase;
@@ -200,202 +222,196 @@ struct DO178C_FlightData_t {
     uint8_t     num_active_faults;
     uint32_t    bit_status_word;
 
-    // --- FULL DESERIALIZATION METHOD ---
-    bool deserialize(const uint8_t* buffer, size_t max_len, size_t& consumed) {
-        LOG_INFO("DO178C_FlightData_t deserialization START. Available Buffer: %zu bytes", max_len);
-
-        bool result = deserialize_from_buffer(
-            buffer, max_len, consumed,
-            // 1. Header
-            packet_sequence_id, system_timestamp_sec, aircraft_id,
-            software_version_major, software_version_minor,
-            // 2. State
-            current_flight_phase, master_system_health,
-            is_autopilot_engaged, is_autothrottle_armed, is_weight_on_wheels,
-            // 3. SubSystem (Nested)
-            sub_system_data,
-            // 4. Nav
-            latitude_deg, longitude_deg, altitude_baro_ft, altitude_radio_ft,
-            altitude_gps_ft, pos_accuracy_h_m, pos_accuracy_v_m,
-            active_nav_source, visible_satellites, waypoint_index,
-            // 5. Dynamics
-            pitch_angle_deg, roll_angle_deg, heading_mag_deg, heading_true_deg,
-            track_angle_deg, drift_angle_deg, pitch_rate_deg_s, roll_rate_deg_s,
-            yaw_rate_deg_s,
-            // 6. Speed
-            airspeed_indicated_kts, airspeed_true_kts, ground_speed_kts,
-            mach_number, vertical_speed_fpm, accel_normal_g, accel_lateral_g,
-            accel_longitudinal_g, angle_of_attack_deg, sideslip_angle_deg,
-            flight_path_angle_deg,
-            // 7. Engine 1
-            eng1_n1_percent, eng1_n2_percent, eng1_egt_c, eng1_fuel_flow_kg_h,
-            eng1_oil_press_psi, eng1_oil_temp_c, eng1_vibration_ips,
-            eng1_throttle_cmd_pct, eng1_fire_warning, eng1_reverser_deployed,
-            // 8. Engine 2
-            eng2_n1_percent, eng2_n2_percent, eng2_egt_c, eng2_fuel_flow_kg_h,
-            eng2_oil_press_psi, eng2_oil_temp_c, eng2_vibration_ips,
-            eng2_throttle_cmd_pct, eng2_fire_warning, eng2_reverser_deployed,
-            // 9. Fuel
-            fuel_qty_left_kg, fuel_qty_right_kg, fuel_qty_center_kg,
-            fuel_qty_total_kg, fuel_temp_c, fuel_pump_l_on, fuel_pump_r_on,
-            // 10. Electrical
-            dc_bus_main_volts, dc_bus_main_amps, bat_1_volts, bat_1_amps,
-            ac_bus_freq_hz, gen_1_load_pct, gen_2_load_pct, ext_power_available,
-            // 11. Hydraulic
-            hyd_press_sys_a_psi, hyd_press_sys_b_psi, hyd_qty_sys_a_pct,
-            hyd_qty_sys_b_pct, brake_pressure_psi, cabin_pressure_psi,
-            cabin_altitude_ft, cabin_rate_fpm,
-            // 12. Controls
-            aileron_pos_l_deg, aileron_pos_r_deg, elevator_pos_l_deg,
-            elevator_pos_r_deg, rudder_pos_deg, flap_handle_pos,
-            flap_actual_pos_l, flap_actual_pos_r, spoiler_pos_pct,
-            trim_stab_units, trim_aileron_units, trim_rudder_units,
-            // 13. Gear
-            gear_nose_status, gear_main_l_status, gear_main_r_status,
-            brake_temp_l_c, brake_temp_r_c, tire_pressure_nose_psi,
-            // 14. Env
-            oat_c, tat_c, wind_speed_kts, wind_direction_deg,
-            air_density_ratio, ice_detected,
-            // 15. AP Targets
-            ap_target_alt_ft, ap_target_speed_kts, ap_target_heading_deg,
-            ap_target_vs_fpm, fms_dist_to_dest_nm, fms_ete_dest_sec,
-            fms_x_track_error_nm, fms_req_nav_perf_nm,
-            // 16. Diag
-            crc32_checksum, frame_counter, cpu_load_percent, num_active_faults,
-            bit_status_word
-        );
-
-        LOG_INFO("DO178C_FlightData_t deserialization END (result=%s, consumed=%zu bytes)", result ? "OK" : "FAIL", consumed);
-        return result;
-    }
+    // Field order comes from wire_layout<DO178C_FlightData_t> (see WIRE LAYOUTS).
+    bool deserialize(const uint8_t* buffer, size_t max_len, size_t& consumed);
+    bool serialize(uint8_t* buffer, size_t max_len, size_t& consumed) const;
+    size_t trueSize() const;
+};
 
-    bool serialize(uint8_t* buffer, size_t max_len, size_t& consumed) const {
-        LOG_INFO("DO178C_FlightData_t serialization START. Available Buffer: %zu bytes", max_len);
-        bool result = serialize_to_buffer(
-            buffer, max_len, consumed,
-            // 1. Header
-            packet_sequence_id, system_timestamp_sec, aircraft_id,
-            software_version_major, software_version_minor,
-            // 2. State
-            current_flight_phase, master_system_health,
-            is_autopilot_engaged, is_autothrottle_armed, is_weight_on_wheels,
-            // 3. SubSystem (Nested)
-            sub_system_data,
-            // 4. Nav
-            latitude_deg, longitude_deg, altitude_baro_ft, altitude_radio_ft,
-            altitude_gps_ft, pos_accuracy_h_m, pos_accuracy_v_m,
-            active_nav_source, visible_satellites, waypoint_index,
-            // 5. Dynamics
-            pitch_angle_deg, roll_angle_deg, heading_mag_deg, heading_true_deg,
-            track_angle_deg, drift_angle_deg, pitch_rate_deg_s, roll_rate_deg_s,
-            yaw_rate_deg_s,
-            // 6. Speed
-            airspeed_indicated_kts, airspeed_true_kts, ground_speed_kts,
-            mach_number, vertical_speed_fpm, accel_normal_g, accel_lateral_g,
-            accel_longitudinal_g, angle_of_attack_deg, sideslip_angle_deg,
-            flight_path_angle_deg,
-            // 7. Engine 1
-            eng1_n1_percent, eng1_n2_percent, eng1_egt_c, eng1_fuel_flow_kg_h,
-            eng1_oil_press_psi, eng1_oil_temp_c, eng1_vibration_ips,
-            eng1_throttle_cmd_pct, eng1_fire_warning, eng1_reverser_deployed,
-            // 8. Engine 2
-            eng2_n1_percent, eng2_n2_percent, eng2_egt_c, eng2_fuel_flow_kg_h,
-            eng2_oil_press_psi, eng2_oil_temp_c, eng2_vibration_ips,
-            eng2_throttle_cmd_pct, eng2_fire_warning, eng2_reverser_deployed,
-            // 9. Fuel
-            fuel_qty_left_kg, fuel_qty_right_kg, fuel_qty_center_kg,
-            fuel_qty_total_kg, fuel_temp_c, fuel_pump_l_on, fuel_pump_r_on,
-            // 10. Electrical
-            dc_bus_main_volts, dc_bus_main_amps, bat_1_volts, bat_1_amps,
-            ac_bus_freq_hz, gen_1_load_pct, gen_2_load_pct, ext_power_available,
-            // 11. Hydraulic
-            hyd_press_sys_a_psi, hyd_press_sys_b_psi, hyd_qty_sys_a_pct,
-            hyd_qty_sys_b_pct, brake_pressure_psi, cabin_pressure_psi,
-            cabin_altitude_ft, cabin_rate_fpm,
-            // 12. Controls
-            aileron_pos_l_deg, aileron_pos_r_deg, elevator_pos_l_deg,
-            elevator_pos_r_deg, rudder_pos_deg, flap_handle_pos,
-            flap_actual_pos_l, flap_actual_pos_r, spoiler_pos_pct,
-            trim_stab_units, trim_aileron_units, trim_rudder_units,
-            // 13. Gear
-            gear_nose_status, gear_main_l_status, gear_main_r_status,
-            brake_temp_l_c, brake_temp_r_c, tire_pressure_nose_psi,
-            // 14. Env
-            oat_c, tat_c, wind_speed_kts, wind_direction_deg,
-            air_density_ratio, ice_detected,
-            // 15. AP Targets
-            ap_target_alt_ft, ap_target_speed_kts, ap_target_heading_deg,
-            ap_target_vs_fpm, fms_dist_to_dest_nm, fms_ete_dest_sec,
-            fms_x_track_error_nm, fms_req_nav_perf_nm,
-            // 16. Diag
-            crc32_checksum, frame_counter, cpu_load_percent, num_active_faults,
-            bit_status_word
-        );
-		return result;
-	}
+// ==========================================
+// WIRE LAYOUTS (single source of field order)
+// ==========================================
 
-    size_t trueSize() const {
-        return calculate_packed_size(
-            // 1. Header
-            packet_sequence_id, system_timestamp_sec, aircraft_id,
-            software_version_major, software_version_minor,
-            // 2. State
-            current_flight_phase, master_system_health,
-            is_autopilot_engaged, is_autothrottle_armed, is_weight_on_wheels,
-            // 3. SubSystem (Nested)
-            sub_system_data,
-            // 4. Nav
-            latitude_deg, longitude_deg, altitude_baro_ft, altitude_radio_ft,
-            altitude_gps_ft, pos_accuracy_h_m, pos_accuracy_v_m,
-            active_nav_source, visible_satellites, waypoint_index,
-            // 5. Dynamics
-            pitch_angle_deg, roll_angle_deg, heading_mag_deg, heading_true_deg,
-            track_angle_deg, drift_angle_deg, pitch_rate_deg_s, roll_rate_deg_s,
-            yaw_rate_deg_s,
-            // 6. Speed
-            airspeed_indicated_kts, airspeed_true_kts, ground_speed_kts,
-            mach_number, vertical_speed_fpm, accel_normal_g, accel_lateral_g,
-            accel_longitudinal_g, angle_of_attack_deg, sideslip_angle_deg,
-            flight_path_angle_deg,
-            // 7. Engine 1
-            eng1_n1_percent, eng1_n2_percent, eng1_egt_c, eng1_fuel_flow_kg_h,
-            eng1_oil_press_psi, eng1_oil_temp_c, eng1_vibration_ips,
-            eng1_throttle_cmd_pct, eng1_fire_warning, eng1_reverser_deployed,
-            // 8. Engine 2
-            eng2_n1_percent, eng2_n2_percent, eng2_egt_c, eng2_fuel_flow_kg_h,
-            eng2_oil_press_psi, eng2_oil_temp_c, eng2_vibration_ips,
-            eng2_throttle_cmd_pct, eng2_fire_warning, eng2_reverser_deployed,
-            // 9. Fuel
-            fuel_qty_left_kg, fuel_qty_right_kg, fuel_qty_center_kg,
-            fuel_qty_total_kg, fuel_temp_c, fuel_pump_l_on, fuel_pump_r_on,
-            // 10. Electrical
-            dc_bus_main_volts, dc_bus_main_amps, bat_1_volts, bat_1_amps,
-            ac_bus_freq_hz, gen_1_load_pct, gen_2_load_pct, ext_power_available,
-            // 11. Hydraulic
-            hyd_press_sys_a_psi, hyd_press_sys_b_psi, hyd_qty_sys_a_pct,
-            hyd_qty_sys_b_pct, brake_pressure_psi, cabin_pressure_psi,
-            cabin_altitude_ft, cabin_rate_fpm,
-            // 12. Controls
-            aileron_pos_l_deg, aileron_pos_r_deg, elevator_pos_l_deg,
-            elevator_pos_r_deg, rudder_pos_deg, flap_handle_pos,
-            flap_actual_pos_l, flap_actual_pos_r, spoiler_pos_pct,
-            trim_stab_units, trim_aileron_units, trim_rudder_units,
-            // 13. Gear
-            gear_nose_status, gear_main_l_status, gear_main_r_status,
-            brake_temp_l_c, brake_temp_r_c, tire_pressure_nose_psi,
-            // 14. Env
-            oat_c, tat_c, wind_speed_kts, wind_direction_deg,
-            air_density_ratio, ice_detected,
-            // 15. AP Targets
-            ap_target_alt_ft, ap_target_speed_kts, ap_target_heading_deg,
-            ap_target_vs_fpm, fms_dist_to_dest_nm, fms_ete_dest_sec,
-            fms_x_track_error_nm, fms_req_nav_perf_nm,
-            // 16. Diag
-            crc32_checksum, frame_counter, cpu_load_percent, num_active_faults,
-			bit_status_word);
-    }
+template <>
+struct wire_layout<SubSystemData> {
+    using type = PackedLayout<&SubSystemData::subId, &SubSystemData::temperature>;
+};
+
+template <>
+struct wire_layout<DO178C_FlightData_t> {
+    using F = DO178C_FlightData_t;
+    using type = PackedLayout<
+        // 1. Header
+        &F::packet_sequence_id, &F::system_timestamp_sec, &F::aircraft_id,
+        &F::software_version_major, &F::software_version_minor, &F::schema_version,
+        // 2. State
+        &F::current_flight_phase, &F::master_system_health,
+        &F::is_autopilot_engaged, &F::is_autothrottle_armed, &F::is_weight_on_wheels,
+        // 3. SubSystem (Nested)
+        &F::sub_system_data,
+        // 4. Nav
+        &F::latitude_deg, &F::longitude_deg, &F::altitude_baro_ft, &F::altitude_radio_ft,
+        &F::altitude_gps_ft, &F::pos_accuracy_h_m, &F::pos_accuracy_v_m,
+        &F::active_nav_source, &F::visible_satellites, &F::waypoint_index,
+        // 5. Dynamics
+        &F::pitch_angle_deg, &F::roll_angle_deg, &F::heading_mag_deg, &F::heading_true_deg,
+        &F::track_angle_deg, &F::drift_angle_deg, &F::pitch_rate_deg_s, &F::roll_rate_deg_s,
+        &F::yaw_rate_deg_s,
+        // 6. Speed
+        &F::airspeed_indicated_kts, &F::airspeed_true_kts, &F::ground_speed_kts,
+        &F::mach_number, &F::vertical_speed_fpm, &F::accel_normal_g, &F::accel_lateral_g,
+        &F::accel_longitudinal_g, &F::angle_of_attack_deg, &F::sideslip_angle_deg,
+        &F::flight_path_angle_deg,
+        // 7. Engine 1
+        &F::eng1_n1_percent, &F::eng1_n2_percent, &F::eng1_egt_c, &F::eng1_fuel_flow_kg_h,
+        &F::eng1_oil_press_psi, &F::eng1_oil_temp_c, &F::eng1_vibration_ips,
+        &F::eng1_throttle_cmd_pct, &F::eng1_fire_warning, &F::eng1_reverser_deployed,
+        // 8. Engine 2
+        &F::eng2_n1_percent, &F::eng2_n2_percent, &F::eng2_egt_c, &F::eng2_fuel_flow_kg_h,
+        &F::eng2_oil_press_psi, &F::eng2_oil_temp_c, &F::eng2_vibration_ips,
+        &F::eng2_throttle_cmd_pct, &F::eng2_fire_warning, &F::eng2_reverser_deployed,
+        // 9. Fuel
+        &F::fuel_qty_left_kg, &F::fuel_qty_right_kg, &F::fuel_qty_center_kg,
+        &F::fuel_qty_total_kg, &F::fuel_temp_c, &F::fuel_pump_l_on, &F::fuel_pump_r_on,
+        // 10. Electrical
+        &F::dc_bus_main_volts, &F::dc_bus_main_amps, &F::bat_1_volts, &F::bat_1_amps,
+        &F::ac_bus_freq_hz, &F::gen_1_load_pct, &F::gen_2_load_pct, &F::ext_power_available,
+        // 11. Hydraulic
+        &F::hyd_press_sys_a_psi, &F::hyd_press_sys_b_psi, &F::hyd_qty_sys_a_pct,
+        &F::hyd_qty_sys_b_pct, &F::brake_pressure_psi, &F::cabin_pressure_psi,
+        &F::cabin_altitude_ft, &F::cabin_rate_fpm,
+        // 12. Controls
+        &F::aileron_pos_l_deg, &F::aileron_pos_r_deg, &F::elevator_pos_l_deg,
+        &F::elevator_pos_r_deg, &F::rudder_pos_deg, &F::flap_handle_pos,
+        &F::flap_actual_pos_l, &F::flap_actual_pos_r, &F::spoiler_pos_pct,
+        &F::trim_stab_units, &F::trim_aileron_units, &F::trim_rudder_units,
+        // 13. Gear
+        &F::gear_nose_status, &F::gear_main_l_status, &F::gear_main_r_status,
+        &F::brake_temp_l_c, &F::brake_temp_r_c, &F::tire_pressure_nose_psi,
+        // 14. Env
+        &F::oat_c, &F::tat_c, &F::wind_speed_kts, &F::wind_direction_deg,
+        &F::air_density_ratio, &F::ice_detected,
+        // 15. AP Targets
+        &F::ap_target_alt_ft, &F::ap_target_speed_kts, &F::ap_target_heading_deg,
+        &F::ap_target_vs_fpm, &F::fms_dist_to_dest_nm, &F::fms_ete_dest_sec,
+        &F::fms_x_track_error_nm, &F::fms_req_nav_perf_nm,
+        // 16. Diag
+        &F::crc32_checksum, &F::frame_counter, &F::cpu_load_percent, &F::num_active_faults,
+        &F::bit_status_word>;
 };
 
+// ==========================================
+// LAYOUT-DRIVEN CODEC
+// ==========================================
+
+bool SubSystemData::deserialize(const uint8_t* buffer, size_t max_len, size_t& consumed) {
+    size_t local_offset = 0;
+    // The pointer is already offset by the parent, so local_offset starts at 0.
+    bool res = wire_layout_t<SubSystemData>::deserialize(*this, buffer, max_len, local_offset);
+    consumed = local_offset;
+    return res;
+}
+
+bool SubSystemData::serialize(uint8_t* buffer, size_t max_len, size_t& consumed) const {
+    size_t local_offset = 0;
+    bool res = wire_layout_t<SubSystemData>::serialize(*this, buffer, max_len, local_offset);
+    consumed = local_offset;
+    return res;
+}
+
+size_t SubSystemData::trueSize() const {
+    // Ignores padding: sizeof(uint16_t) + sizeof(float) = 6.
+    return wire_layout_t<SubSystemData>::size;
+}
+
+bool DO178C_FlightData_t::deserialize(const uint8_t* buffer, size_t max_len, size_t& consumed) {
+    LOG_INFO("DO178C_FlightData_t deserialization START. Available Buffer: %zu bytes", max_len);
+    bool result = wire_layout_t<DO178C_FlightData_t>::deserialize(*this, buffer, max_len, consumed);
+    LOG_INFO("DO178C_FlightData_t deserialization END (result=%s, consumed=%zu bytes)", result ? "OK" : "FAIL", consumed);
+    return result;
+}
+
+bool DO178C_FlightData_t::serialize(uint8_t* buffer, size_t max_len, size_t& consumed) const {
+    LOG_INFO("DO178C_FlightData_t serialization START. Available Buffer: %zu bytes", max_len);
+    return wire_layout_t<DO178C_FlightData_t>::serialize(*this, buffer, max_len, consumed);
+}
+
+size_t DO178C_FlightData_t::trueSize() const {
+    return wire_layout_t<DO178C_FlightData_t>::size;
+}
+
+// schema_version tracks the wire layout independently of software releases.
+// v0 recorder files predate the diagnostic block (crc32_checksum onwards).
+template <>
+struct schema_history<DO178C_FlightData_t> {
+    using F = DO178C_FlightData_t;
+    static constexpr auto version_field = &F::schema_version;
+    static constexpr uint8_t current_version = FLIGHT_SCHEMA_VERSION;
+    static constexpr std::array<SchemaRevision, 1> revisions = { {
+        { 0, wire_layout_t<F>::index_of<&F::crc32_checksum>() }
+    } };
+    static constexpr std::array<DeprecatedField, 0> deprecated = {};
+};
+
+// ==========================================
+// VALID RANGES (deserialize_validated)
+// ==========================================
+
+template <>
+struct field_range<&DO178C_FlightData_t::latitude_deg> {
+    static constexpr bool enabled = true;
+    static constexpr double min_value = -90.0;
+    static constexpr double max_value = 90.0;
+};
+template <>
+struct field_range<&DO178C_FlightData_t::longitude_deg> {
+    static constexpr bool enabled = true;
+    static constexpr double min_value = -180.0;
+    static constexpr double max_value = 180.0;
+};
+template <>
+struct field_range<&DO178C_FlightData_t::pitch_angle_deg> {
+    static constexpr bool enabled = true;
+    static constexpr double min_value = -90.0;
+    static constexpr double max_value = 90.0;
+};
+template <>
+struct field_range<&DO178C_FlightData_t::roll_angle_deg> {
+    static constexpr bool enabled = true;
+    static constexpr double min_value = -180.0;
+    static constexpr double max_value = 180.0;
+};
+template <>
+struct field_range<&DO178C_FlightData_t::heading_mag_deg> {
+    static constexpr bool enabled = true;
+    static constexpr double min_value = 0.0;
+    static constexpr double max_value = 360.0;
+};
+template <>
+struct field_range<&DO178C_FlightData_t::heading_true_deg> {
+    static constexpr bool enabled = true;
+    static constexpr double min_value = 0.0;
+    static constexpr double max_value = 360.0;
+};
+template <>
+struct field_range<&DO178C_FlightData_t::mach_number> {
+    static constexpr bool enabled = true;
+    static constexpr double min_value = 0.0;
+    static constexpr double max_value = 1.0;
+};
+template <>
+struct field_range<&DO178C_FlightData_t::cpu_load_percent> {
+    static constexpr bool enabled = true;
+    static constexpr double min_value = 0.0;
+    static constexpr double max_value = 100.0;
+};
+
+using TelemetryRegistry = MessageRegistry<
+    MessageEntry<0x01, SubSystemData>,
+    MessageEntry<0x02, DO178C_FlightData_t>>;
+
+using FlightBufferPool = FrameBufferPool<DO178C_FlightData_t, 64>;
+
 // ==========================================
 // 3. TEST HARNESS (MAIN)
 // ==========================================
@@ -405,6 +421,19 @@ bool is_close(double a, double b, double epsilon = 0.001) {
     return std::fabs(a - b) < epsilon;
 }
 
+#if defined(__linux__)
+using PipeFrameReader = AsyncFrameReader<FdByteSource, 4096>;
+
+// Drains a link frame by frame until the source ends.
+AsyncTask consume_flight_frames(PipeFrameReader& reader, size_t& framesDecoded) {
+    for (;;) {
+        AsyncFrameResult<DO178C_FlightData_t> result = co_await reader.next<DO178C_FlightData_t>();
+        if (!result.ok) co_return;
+        framesDecoded++;
+    }
+}
+#endif
+
 int main() {
 #ifdef TEST_ENV
     LOG_INFO("========================================");
@@ -556,10 +585,13 @@ int main() {
 	// 2. SERIALIZATION
     LOG_INFO("[STEP 1] Serializing Flight Data...");
 	constexpr size_t MAX_BUFFER_SIZE = 2048;
-	uint8_t serializedBuffer[MAX_BUFFER_SIZE] = {};
+	static FlightBufferPool bufferPool;
+	FlightBufferPool::Handle serializedHandle = bufferPool.acquire();
+	uint8_t* serializedBuffer = serializedHandle.data();
 	size_t bufPos = 0;
 
-	bool serResult = originalData.serialize(serializedBuffer, MAX_BUFFER_SIZE, bufPos);
+	bool serResult = serializedHandle.valid() &&
+		originalData.serialize(serializedBuffer, FlightBufferPool::Handle::size(), bufPos);
 
     if (serResult) {
         LOG_INFO("Serialization SUCCESS. Total Bytes Written: %zu", bufPos);
@@ -604,6 +636,458 @@ int main() {
         LOG_ERROR("Deserialization returned FALSE.");
     }
 
+    // 5. ARENA BATCH DECODE
+    LOG_INFO("[STEP 4] Arena Batch Decode...");
+    constexpr size_t BATCH_FRAMES = 2;
+    uint8_t batchBuffer[MAX_BUFFER_SIZE] = {};
+    size_t batchPos = 0;
+    for (size_t i = 0; i < BATCH_FRAMES; ++i) {
+        size_t written = 0;
+        if (!originalData.serialize(batchBuffer + batchPos, MAX_BUFFER_SIZE - batchPos, written)) {
+            LOG_ERROR("Batch serialization FAILED."); return -1;
+        }
+        batchPos += written;
+    }
+
+    static StaticArena<4096> decodeArena;
+    size_t batchConsumed = 0;
+    DO178C_FlightData_t* batch = arena_deserialize_batch<DO178C_FlightData_t>(
+        decodeArena, batchBuffer, batchPos, BATCH_FRAMES, batchConsumed);
+
+    if ((batch != nullptr) && (batchConsumed == batchPos) &&
+        (batch[BATCH_FRAMES - 1].packet_sequence_id == originalData.packet_sequence_id)) {
+        LOG_INFO("SUCCESS: %zu frames decoded, arena used %zu bytes", BATCH_FRAMES, decodeArena.used());
+    }
+    else {
+        LOG_ERROR("FAILURE: Arena batch decode.");
+    }
+    decodeArena.reset();
+
+    // Owned variable-length data must survive the input buffer and vanish on reset().
+    float exceedances[3] = { 1.5f, -2.25f, 99.0f };
+    MaintenanceLog_t sourceLog = {};
+    sourceLog.aircraft_id = 0x1234;
+    sourceLog.exceedance_values.data = exceedances;
+    sourceLog.exceedance_values.count = 3;
+    uint8_t logBuffer[64] = {};
+    size_t logLen = 0;
+    size_t logConsumed = 0;
+    bool logResult = sourceLog.serialize(logBuffer, sizeof(logBuffer), logLen);
+    MaintenanceLog_t* decodedLog = logResult ?
+        arena_deserialize<MaintenanceLog_t>(decodeArena, logBuffer, logLen, logConsumed) : nullptr;
+    std::fill(logBuffer, logBuffer + sizeof(logBuffer), static_cast<uint8_t>(0xFF));
+
+    logResult = (decodedLog != nullptr) && (logConsumed == logLen) && (decodedLog->aircraft_id == 0x1234) &&
+        (decodedLog->exceedance_values.count == 3U);
+    for (uint16_t i = 0; logResult && (i < 3U); ++i) {
+        logResult = (decodedLog->exceedance_values.data[i] == exceedances[i]);
+    }
+    // A count the remaining bytes cannot cover is rejected before any allocation.
+    sourceLog.serialize(logBuffer, sizeof(logBuffer), logLen);
+    logBuffer[2] = 0xFF;
+    decodeArena.reset();
+    const bool forgedRejected = (decodeArena.used() == 0U) &&
+        (arena_deserialize<MaintenanceLog_t>(decodeArena, logBuffer, logLen, logConsumed) == nullptr) &&
+        (decodeArena.used() == sizeof(MaintenanceLog_t));
+    decodeArena.reset();
+
+    if (logResult && forgedRejected && (decodeArena.used() == 0U)) {
+        LOG_INFO("SUCCESS: Arena-owned array outlived its input buffer and was released by reset()");
+    }
+    else {
+        LOG_ERROR("FAILURE: Arena-owned array decode.");
+    }
+
+    // 6. IN-PLACE PATCH
+    LOG_INFO("[STEP 5] Patching Serialized Frame In Place...");
+    static_assert(wire_layout_t<DO178C_FlightData_t>::size == 461, "Wire format size changed");
+    bool patchResult = patch_fields<&DO178C_FlightData_t::frame_counter, &DO178C_FlightData_t::system_timestamp_sec>(
+        serializedBuffer, bufPos, static_cast<uint16_t>(originalData.frame_counter + 1U), originalData.system_timestamp_sec + 0.05);
+
+    uint16_t patchedCounter = 0;
+    double patchedTimestamp = 0.0;
+    if (patchResult &&
+        peek_field<&DO178C_FlightData_t::frame_counter>(serializedBuffer, bufPos, patchedCounter) &&
+        peek_field<&DO178C_FlightData_t::system_timestamp_sec>(serializedBuffer, bufPos, patchedTimestamp) &&
+        (patchedCounter == originalData.frame_counter + 1U) &&
+        is_close(patchedTimestamp, originalData.system_timestamp_sec + 0.05)) {
+        LOG_INFO("SUCCESS: Patched fields read back correctly.");
+    }
+    else {
+        LOG_ERROR("FAILURE: In-place patch.");
+    }
+
+    // 7. MULTIPLEXED STREAM
+    LOG_INFO("[STEP 6] Decoding Multiplexed Message Stream...");
+    uint8_t streamBuffer[MAX_BUFFER_SIZE] = {};
+    size_t streamPos = 0;
+    size_t encoded = 0;
+    bool encodeResult = TelemetryRegistry::encode(originalData.sub_system_data, streamBuffer, MAX_BUFFER_SIZE, encoded);
+    streamPos += encoded;
+    encodeResult = encodeResult && TelemetryRegistry::encode(originalData, streamBuffer + streamPos, MAX_BUFFER_SIZE - streamPos, encoded);
+    streamPos += encoded;
+
+    struct StreamCounter {
+        size_t subsystems = 0;
+        size_t flightFrames = 0;
+        void operator()(const SubSystemData&) { subsystems++; }
+        void operator()(const DO178C_FlightData_t&) { flightFrames++; }
+    } counter;
+
+    size_t streamConsumed = 0;
+    StreamStatus_e streamStatus = TelemetryRegistry::decode_stream(streamBuffer, streamPos, streamConsumed, counter);
+    if (encodeResult && (streamStatus == STREAM_STATUS_OK) && (streamConsumed == streamPos) &&
+        (counter.subsystems == 1U) && (counter.flightFrames == 1U)) {
+        LOG_INFO("SUCCESS: Stream demultiplexed (%zu bytes).", streamConsumed);
+    }
+    else {
+        LOG_ERROR("FAILURE: Stream demultiplexing (status=%u).", static_cast<unsigned int>(streamStatus));
+    }
+
+    // 8. LEGACY SCHEMA DECODE
+    LOG_INFO("[STEP 7] Decoding Legacy (v0) Recorder Frame...");
+    constexpr size_t LEGACY_FRAME_SIZE = wire_layout_t<DO178C_FlightData_t>::offset_of<&DO178C_FlightData_t::crc32_checksum>();
+    uint8_t legacyBuffer[MAX_BUFFER_SIZE] = {};
+    std::copy(serializedBuffer, serializedBuffer + LEGACY_FRAME_SIZE, legacyBuffer);
+    bool legacyResult = patch_field<&DO178C_FlightData_t::schema_version>(legacyBuffer, LEGACY_FRAME_SIZE, 0);
+
+    DO178C_FlightData_t legacyData = {};
+    size_t legacyConsumed = 0;
+    legacyResult = legacyResult && deserialize_versioned(legacyData, legacyBuffer, LEGACY_FRAME_SIZE, legacyConsumed);
+    if (legacyResult && (legacyConsumed == LEGACY_FRAME_SIZE) &&
+        is_close(legacyData.latitude_deg, originalData.latitude_deg) && (legacyData.bit_status_word == 0U)) {
+        LOG_INFO("SUCCESS: v0 frame decoded, diagnostic block defaulted.");
+    }
+    else {
+        LOG_ERROR("FAILURE: Legacy schema decode.");
+    }
+
+    // A v2 frame from a newer recorder (current layout plus an unknown tail)
+    // followed by a current one. Without its length the v2 frame is rejected
+    // rather than swallowing the rest of the recording.
+    constexpr size_t NEWER_TAIL_SIZE = 8;
+    constexpr size_t NEWER_FRAME_SIZE = wire_layout_t<DO178C_FlightData_t>::size + NEWER_TAIL_SIZE;
+    uint8_t newerBuffer[MAX_BUFFER_SIZE] = {};
+    std::copy(serializedBuffer, serializedBuffer + bufPos, newerBuffer);
+    std::copy(serializedBuffer, serializedBuffer + bufPos, newerBuffer + NEWER_FRAME_SIZE);
+    bool newerResult = patch_field<&DO178C_FlightData_t::schema_version>(newerBuffer, bufPos, 2);
+    DO178C_FlightData_t newerData = {};
+    size_t newerConsumed = 0;
+    const size_t newerRecordingLen = NEWER_FRAME_SIZE + bufPos;
+    newerResult = newerResult && !deserialize_versioned(newerData, newerBuffer, newerRecordingLen, newerConsumed);
+    newerResult = newerResult &&
+        deserialize_versioned(newerData, newerBuffer, newerRecordingLen, newerConsumed, NEWER_FRAME_SIZE);
+    size_t nextConsumed = 0;
+    newerResult = newerResult && (newerConsumed == NEWER_FRAME_SIZE) &&
+        deserialize_versioned(newerData, newerBuffer + newerConsumed, newerRecordingLen - newerConsumed, nextConsumed);
+    if (newerResult && (newerConsumed + nextConsumed == newerRecordingLen) &&
+        (newerData.bit_status_word == originalData.bit_status_word)) {
+        LOG_INFO("SUCCESS: v2 frame decoded through the current layout, tail skipped.");
+    }
+    else {
+        LOG_ERROR("FAILURE: Newer schema decode.");
+    }
+
+    // 9. PREDICATE SCAN
+    LOG_INFO("[STEP 8] Scanning Frames for EGT Exceedance (airborne)...");
+    using Flight = DO178C_FlightData_t;
+    constexpr size_t FRAME_SIZE = wire_layout_t<Flight>::size;
+    constexpr size_t SCAN_FRAMES = 20;
+    static uint8_t scanBuffer[FRAME_SIZE * SCAN_FRAMES] = {};
+    bool scanSetup = true;
+    for (size_t i = 0; i < SCAN_FRAMES; ++i) {
+        uint8_t* frame = scanBuffer + (i * FRAME_SIZE);
+        std::copy(serializedBuffer, serializedBuffer + FRAME_SIZE, frame);
+        // Frames 3 and 17 exceed 600 C; frame 17 is on the ground.
+        const float egt = ((i == 3U) || (i == 17U)) ? 640.0f : 580.0f;
+        scanSetup = scanSetup && patch_fields<&Flight::eng1_egt_c, &Flight::is_weight_on_wheels>(
+            frame, FRAME_SIZE, egt, static_cast<uint8_t>(i == 17U));
+    }
+
+    auto exceedance = scan_and(field_gt<&Flight::eng1_egt_c>(600.0f), field_eq<&Flight::is_weight_on_wheels>(0));
+    uint32_t matchIndices[SCAN_FRAMES] = {};
+    size_t framesScanned = 0;
+    size_t matchCount = scan_frames(scanBuffer, sizeof(scanBuffer), FRAME_SIZE, SCAN_FRAMES, exceedance, matchIndices, SCAN_FRAMES, framesScanned);
+    // Block 0 has no frame on the ground and every frame is below 1000 C, so
+    // both right-hand sides are skipped there without changing the result.
+    uint32_t groundIndices[SCAN_FRAMES] = {};
+    size_t groundScanned = 0;
+    const size_t groundCount = scan_frames(scanBuffer, sizeof(scanBuffer), FRAME_SIZE, SCAN_FRAMES,
+        scan_and(field_eq<&Flight::is_weight_on_wheels>(1), field_gt<&Flight::eng1_egt_c>(600.0f)),
+        groundIndices, SCAN_FRAMES, groundScanned);
+    uint32_t anyIndices[SCAN_FRAMES] = {};
+    const size_t anyCount = scan_frames(scanBuffer, sizeof(scanBuffer), FRAME_SIZE, SCAN_FRAMES,
+        scan_or(field_lt<&Flight::eng1_egt_c>(1000.0f), exceedance), anyIndices, SCAN_FRAMES, groundScanned);
+    // An overstated frame count is clamped to the buffer instead of read past it.
+    const size_t clampedCount = scan_frames(scanBuffer, sizeof(scanBuffer) - 1U, FRAME_SIZE, SCAN_FRAMES + 4U,
+        scan_or(field_lt<&Flight::eng1_egt_c>(1000.0f), exceedance), anyIndices, SCAN_FRAMES, groundScanned);
+    scanSetup = scanSetup && (groundCount == 1U) && (groundIndices[0] == 17U) && (anyCount == SCAN_FRAMES) &&
+        (clampedCount == SCAN_FRAMES - 1U) && (groundScanned == SCAN_FRAMES - 1U);
+
+    if (scanSetup && (matchCount == 1U) && (matchIndices[0] == 3U) && (framesScanned == SCAN_FRAMES)) {
+        LOG_INFO("SUCCESS: Exceedance found in frame %u.", static_cast<unsigned int>(matchIndices[0]));
+    }
+    else {
+        LOG_ERROR("FAILURE: Predicate scan (%zu matches).", matchCount);
+    }
+
+    // 10. FUSED AGGREGATION
+    LOG_INFO("[STEP 9] Aggregating Flight Statistics...");
+    std::array<FieldStats, 2> flightStats = { make_field_stats(600.0), make_field_stats() };
+    bool aggResult = aggregate_frames<&Flight::eng1_egt_c, &Flight::mach_number>(scanBuffer, sizeof(scanBuffer), FRAME_SIZE, SCAN_FRAMES, flightStats);
+    std::array<FieldStats, 2> overrunStats = { make_field_stats(), make_field_stats() };
+    aggResult = aggResult && !aggregate_frames<&Flight::eng1_egt_c, &Flight::mach_number>(
+        scanBuffer, sizeof(scanBuffer), FRAME_SIZE, SCAN_FRAMES + 1U, overrunStats) && (overrunStats[0].count == 0U);
+    const double expectedEgtMean = ((18.0 * 580.0) + (2.0 * 640.0)) / 20.0;
+
+    // A dropout sensor (NaN/Inf) is counted aside instead of poisoning the stats.
+    FieldStats dropoutStats = make_field_stats(2.0);
+    const double dropoutSamples[4] = { 1.0, std::numeric_limits<double>::quiet_NaN(), 3.0,
+        std::numeric_limits<double>::infinity() };
+    merge_block_stats(dropoutStats, dropoutSamples, 4U);
+    aggResult = aggResult && (dropoutStats.count == 2U) && (dropoutStats.non_finite == 2U) &&
+        (dropoutStats.exceedances == 1U) && is_close(dropoutStats.mean, 2.0) &&
+        is_close(dropoutStats.min, 1.0) && is_close(dropoutStats.max, 3.0);
+
+    if (aggResult && (flightStats[0].count == SCAN_FRAMES) && (flightStats[0].exceedances == 2U) &&
+        is_close(flightStats[0].mean, expectedEgtMean) && is_close(flightStats[0].max, 640.0) &&
+        is_close(flightStats[1].variance(), 0.0)) {
+        LOG_INFO("SUCCESS: EGT mean %.2f, stddev %.2f, %llu exceedances.", flightStats[0].mean,
+            std::sqrt(flightStats[0].variance()), static_cast<unsigned long long>(flightStats[0].exceedances));
+    }
+    else {
+        LOG_ERROR("FAILURE: Fused aggregation.");
+    }
+
+    // 11. TRIPLE-REDUNDANT VOTE
+    LOG_INFO("[STEP 10] Voting Three Redundant Channels...");
+    uint8_t channelA[FRAME_SIZE] = {};
+    uint8_t channelB[FRAME_SIZE] = {};
+    uint8_t channelC[FRAME_SIZE] = {};
+    uint8_t votedFrame[FRAME_SIZE] = {};
+    std::copy(serializedBuffer, serializedBuffer + FRAME_SIZE, channelA);
+    std::copy(serializedBuffer, serializedBuffer + FRAME_SIZE, channelB);
+    std::copy(serializedBuffer, serializedBuffer + FRAME_SIZE, channelC);
+    bool voteSetup = patch_field<&Flight::aircraft_id>(channelB, FRAME_SIZE, 0x4321) &&
+        patch_field<&Flight::mach_number>(channelC, FRAME_SIZE, originalData.mach_number + 0.0001f);
+
+    VoteReport<Flight> voteReport;
+    bool voteResult = vote_frames<Flight>(channelA, channelB, channelC, FRAME_SIZE, votedFrame, FRAME_SIZE, 0.001, voteReport);
+    constexpr size_t AIRCRAFT_ID_INDEX = wire_layout_t<Flight>::index_of<&Flight::aircraft_id>();
+    constexpr size_t MACH_INDEX = wire_layout_t<Flight>::index_of<&Flight::mach_number>();
+    uint16_t votedAircraft = 0;
+
+    // With a single finite channel that channel is output, still flagged.
+    uint8_t lanes[3][sizeof(float)] = {};
+    uint8_t singleVote[sizeof(float)] = {};
+    safe_write_to_buffer(lanes[0], safe_hton(std::nanf("")));
+    safe_write_to_buffer(lanes[1], safe_hton(5.0f));
+    safe_write_to_buffer(lanes[2], safe_hton(std::numeric_limits<float>::infinity()));
+    const VoteOutcome singleOutcome = vote_float_field<float>(lanes[0], lanes[1], lanes[2], singleVote, 0.001);
+    float singleValue = 0.0f;
+    safe_read_from_buffer(singleValue, singleVote);
+    voteSetup = voteSetup && singleOutcome.unresolved && (safe_ntoh(singleValue) == 5.0f);
+
+    if (voteSetup && voteResult && (voteReport.disagreement.count() == 2U) && voteReport.unresolved.none() &&
+        voteReport.disagreement[AIRCRAFT_ID_INDEX] && voteReport.disagreement[MACH_INDEX] &&
+        peek_field<&Flight::aircraft_id>(votedFrame, FRAME_SIZE, votedAircraft) &&
+        (votedAircraft == originalData.aircraft_id)) {
+        LOG_INFO("SUCCESS: Voted frame masks single-channel faults.");
+    }
+    else {
+        LOG_ERROR("FAILURE: Redundant channel vote.");
+    }
+
+    // 12. FUSED VALIDATION
+    LOG_INFO("[STEP 11] Decoding With Range/NaN Validation...");
+    uint8_t invalidFrame[FRAME_SIZE] = {};
+    std::copy(serializedBuffer, serializedBuffer + FRAME_SIZE, invalidFrame);
+    bool validationSetup = patch_fields<&Flight::mach_number, &Flight::cpu_load_percent, &Flight::oat_c>(
+        invalidFrame, FRAME_SIZE, 1.2f, static_cast<uint8_t>(140), std::nanf(""));
+    // A NaN inside the nested block is reported on the parent field.
+    constexpr size_t SUB_OFFSET = wire_layout_t<Flight>::offset_of<&Flight::sub_system_data>();
+    validationSetup = validationSetup &&
+        patch_field<&SubSystemData::temperature>(invalidFrame + SUB_OFFSET, FRAME_SIZE - SUB_OFFSET, std::nanf(""));
+
+    DO178C_FlightData_t validatedData = {};
+    ValidationReport<Flight> validReport;
+    ValidationReport<Flight> invalidReport;
+    size_t validatedConsumed = 0;
+    bool validationResult = validationSetup &&
+        deserialize_validated(validatedData, serializedBuffer, bufPos, validatedConsumed, validReport) &&
+        deserialize_validated(validatedData, invalidFrame, FRAME_SIZE, validatedConsumed, invalidReport);
+    if (validationResult && validReport.violations.none() && (invalidReport.violations.count() == 4U) &&
+        invalidReport.violations[wire_layout_t<Flight>::index_of<&Flight::sub_system_data>()] &&
+        invalidReport.violations[wire_layout_t<Flight>::index_of<&Flight::mach_number>()] &&
+        invalidReport.violations[wire_layout_t<Flight>::index_of<&Flight::cpu_load_percent>()] &&
+        invalidReport.violations[wire_layout_t<Flight>::index_of<&Flight::oat_c>()]) {
+        LOG_INFO("SUCCESS: Range and NaN violations flagged in a single pass.");
+    }
+    else {
+        LOG_ERROR("FAILURE: Fused validation.");
+    }
+
+#if defined(__linux__)
+    // 13. BATCHED DATAGRAM TRANSPORT
+    LOG_INFO("[STEP 12] Sending Frame Batch Over Unix Datagram Pair...");
+    using TelemetrySocket = BatchDatagramSocket<8, 512>;
+    static TelemetrySocket txSocket;
+    static TelemetrySocket rxSocket;
+    DO178C_FlightData_t txFrames[2] = { originalData, originalData };
+    txFrames[1].frame_counter = static_cast<uint16_t>(originalData.frame_counter + 1U);
+    DO178C_FlightData_t rxFrames[2] = {};
+
+    size_t framesSent = 0;
+    size_t framesReceived = 0;
+    if (TelemetrySocket::open_pair(txSocket, rxSocket)) {
+        framesSent = txSocket.send_batch(txFrames, 2);
+        framesReceived = rxSocket.receive_batch(rxFrames, 2, MSG_DONTWAIT);
+    }
+    if ((framesSent == 2U) && (framesReceived == 2U) && (rxFrames[1].frame_counter == txFrames[1].frame_counter)) {
+        LOG_INFO("SUCCESS: %zu frames in one sendmmsg/recvmmsg round trip.", framesReceived);
+    }
+    else {
+        LOG_ERROR("FAILURE: Batched transport (sent=%zu, received=%zu).", framesSent, framesReceived);
+    }
+#endif
+
+    // 14. RECORDER REPLAY
+    LOG_INFO("[STEP 13] Replaying Recorded Frames...");
+    bool replaySetup = true;
+    for (size_t i = 0; i < SCAN_FRAMES; ++i) {
+        replaySetup = replaySetup && patch_field<&Flight::system_timestamp_sec>(
+            scanBuffer + (i * FRAME_SIZE), FRAME_SIZE, originalData.system_timestamp_sec + (0.01 * static_cast<double>(i)));
+    }
+
+    RecorderReplay<&Flight::system_timestamp_sec> replay(scanBuffer, sizeof(scanBuffer));
+    size_t replayedFrames = 0;
+    auto countingSink = [&replayedFrames](const uint8_t*, size_t, size_t count) {
+        replayedFrames += count;
+        return true;
+    };
+    ReplayStats fastStats = replay.run(ReplayConfig{ REPLAY_MODE_AS_FAST_AS_POSSIBLE, 1.0, 8 }, countingSink);
+    ReplayStats pacedStats = replay.run(ReplayConfig{ REPLAY_MODE_PACED, 20.0, 8 }, countingSink);
+
+    // Discontinuities (a two-hour gap, a 1e12 s jump, a NaN) must neither stall nor overflow the schedule.
+    constexpr size_t GAP_FRAMES = 5;
+    static uint8_t gapRecording[FRAME_SIZE * GAP_FRAMES] = {};
+    const double gapTimestamps[GAP_FRAMES] = { 100.0, 7300.0, 1.0e12, std::numeric_limits<double>::quiet_NaN(), 1.0e12 + 0.01 };
+    for (size_t i = 0; i < GAP_FRAMES; ++i) {
+        std::copy(scanBuffer, scanBuffer + FRAME_SIZE, gapRecording + (i * FRAME_SIZE));
+        replaySetup = replaySetup && patch_field<&Flight::system_timestamp_sec>(
+            gapRecording + (i * FRAME_SIZE), FRAME_SIZE, gapTimestamps[i]);
+    }
+    RecorderReplay<&Flight::system_timestamp_sec> gapReplay(gapRecording, sizeof(gapRecording));
+    const auto gapStart = std::chrono::steady_clock::now();
+    ReplayStats gapStats = gapReplay.run(ReplayConfig{ REPLAY_MODE_PACED, 1.0, 8 }, countingSink);
+    const bool gapOnTime = (std::chrono::steady_clock::now() - gapStart) < std::chrono::seconds(1);
+
+    if (replaySetup && (fastStats.frames_delivered == SCAN_FRAMES) && (fastStats.batches_delivered == 3U) &&
+        (pacedStats.frames_delivered == SCAN_FRAMES) && (gapStats.frames_delivered == GAP_FRAMES) && gapOnTime &&
+        (replayedFrames == (2U * SCAN_FRAMES) + GAP_FRAMES)) {
+        LOG_INFO("SUCCESS: Replayed %zu frames (paced run used %zu batches).", replayedFrames, pacedStats.batches_delivered);
+    }
+    else {
+        LOG_ERROR("FAILURE: Recorder replay.");
+    }
+
+#if defined(__linux__)
+    // 15. COROUTINE DECODE
+    LOG_INFO("[STEP 14] Coroutine Decode Over a Pipe...");
+    int pipeFds[2] = { -1, -1 };
+    size_t asyncDecoded = 0;
+    bool asyncSetup = (::pipe(pipeFds) == 0) && FdByteSource::set_nonblocking(pipeFds[0]);
+    if (asyncSetup) {
+        EpollLoop loop;
+        FdByteSource pipeSource(pipeFds[0]);
+        PipeFrameReader reader(pipeSource, loop);
+
+        // Half a frame first: the coroutine has to suspend until the rest arrives.
+        asyncSetup = ::write(pipeFds[1], scanBuffer, FRAME_SIZE / 2U) == static_cast<ssize_t>(FRAME_SIZE / 2U);
+        consume_flight_frames(reader, asyncDecoded);
+        asyncSetup = asyncSetup && (asyncDecoded == 0U) &&
+            (::write(pipeFds[1], scanBuffer + (FRAME_SIZE / 2U), (2U * FRAME_SIZE) - (FRAME_SIZE / 2U)) > 0);
+        ::close(pipeFds[1]);
+        loop.run();
+        ::close(pipeFds[0]);
+    }
+    if (asyncSetup && (asyncDecoded == 2U)) {
+        LOG_INFO("SUCCESS: %zu frames decoded by a suspended coroutine.", asyncDecoded);
+    }
+    else {
+        LOG_ERROR("FAILURE: Coroutine decode (%zu frames).", asyncDecoded);
+    }
+#endif
+
+    // 16. POOLED BUFFER HANDOFF
+    LOG_INFO("[STEP 15] Handing a Pooled Buffer to I/O...");
+    FlightBufferPool::Handle txHandle = bufferPool.acquire();
+    uint8_t* const txSlot = txHandle.data();
+    size_t txPos = 0;
+    bool poolResult = txHandle.valid() &&
+        (reinterpret_cast<uintptr_t>(txSlot) % FlightBufferPool::CACHE_LINE == 0U) &&
+        originalData.serialize(txSlot, FlightBufferPool::Handle::size(), txPos);
+
+    FlightBufferPool::Handle ioHandle = txHandle;   // I/O path keeps the slot alive
+    txHandle.reset();
+    poolResult = poolResult && (ioHandle.data() == txSlot) && (txPos == FRAME_SIZE);
+    ioHandle.reset();                               // Last reference: slot goes back to this thread's cache
+
+    FlightBufferPool::Handle reusedHandle = bufferPool.acquire();
+    poolResult = poolResult && (reusedHandle.data() == txSlot);
+
+    // Alternating between two pools keeps both thread caches warm: no slot
+    // goes back to either shared list after the first refill.
+    using ProbePool = SerializationBufferPool<64, 32>;
+    std::unique_ptr<ProbePool> poolA = std::make_unique<ProbePool>();
+    std::unique_ptr<ProbePool> poolB = std::make_unique<ProbePool>();
+    size_t warmFreeA = 0;
+    size_t warmFreeB = 0;
+    for (int i = 0; i < 10; ++i) {
+        ProbePool::Handle a = poolA->acquire();
+        ProbePool::Handle b = poolB->acquire();
+        if (i == 0) {
+            warmFreeA = poolA->shared_free();
+            warmFreeB = poolB->shared_free();
+        }
+    }
+    poolResult = poolResult && (warmFreeA < 32U) && (poolA->shared_free() == warmFreeA) &&
+        (poolB->shared_free() == warmFreeB);
+    poolB.reset();
+
+    // Slots parked in an idle thread's cache are reclaimed once the shared list
+    // runs dry, and a pool destroyed before that thread exits is detached from it.
+    std::atomic<int> probeStage{ 0 };
+    std::thread idleThread([&poolA, &probeStage]() {
+        { ProbePool::Handle parked = poolA->acquire(); }
+        probeStage.store(1);
+        while (probeStage.load() != 2) std::this_thread::yield();
+        { ProbePool::Handle parked = poolA->acquire(); }
+        probeStage.store(3);
+        while (probeStage.load() != 4) std::this_thread::yield();
+    });
+    while (probeStage.load() != 1) std::this_thread::yield();
+    ProbePool::Handle probeHandles[32];
+    size_t probeAcquired = 0;
+    for (ProbePool::Handle& handle : probeHandles) {
+        handle = poolA->acquire();
+        if (handle.valid()) probeAcquired++;
+    }
+    for (ProbePool::Handle& handle : probeHandles) handle.reset();
+    probeStage.store(2);
+    while (probeStage.load() != 3) std::this_thread::yield();
+    poolA.reset();
+    probeStage.store(4);
+    idleThread.join();
+    poolResult = poolResult && (probeAcquired == 32U);
+
+    if (poolResult) {
+        LOG_INFO("SUCCESS: Slot recycled without allocation or zeroing.");
+    }
+    else {
+        LOG_ERROR("FAILURE: Buffer pool handoff.");
+    }
+
 #endif
     return 0;
 }
\ No newline at end of file